@@ -0,0 +1,85 @@
+extends SceneTree
+
+# Times calls from GDScript into Dart through the BridgeBenchmark class in
+# src/bridge_benchmark.dart, which is only registered when GODOT_DART_BENCHMARK
+# is set. Run from the repository root with
+#
+#   GODOT_DART_BENCHMARK=1 godot --headless --path simple --script benchmark.gd
+#
+# and compare the numbers between two builds of the extension.
+
+const CALLS = 200000
+const INSTANCES = 20000
+const STRING_CHARS = 64 * 1024 * 1024
+
+func _init():
+	if not ClassDB.class_exists("BridgeBenchmark"):
+		print("BridgeBenchmark isn't registered, run with GODOT_DART_BENCHMARK set")
+		quit(1)
+		return
+
+	var bench = ClassDB.instantiate("BridgeBenchmark")
+
+	# Warm up, so the first calls don't pay for compiling the Dart side
+	for i in 1000:
+		bench.noop()
+		bench.echo(i)
+
+	var start = Time.get_ticks_usec()
+	for i in CALLS:
+		bench.noop()
+	var elapsed = Time.get_ticks_usec() - start
+	print("noop: %.1f ns per call" % (elapsed * 1000.0 / CALLS))
+
+	# An argument and a return value, converted through the helpers the native
+	# side invokes by name
+	start = Time.get_ticks_usec()
+	for i in CALLS:
+		bench.echo(i)
+	elapsed = Time.get_ticks_usec() - start
+	print("echo: %.1f ns per call" % (elapsed * 1000.0 / CALLS))
+
+	# Creating an instance reads its native pointer by name, and entering and
+	# leaving the tree looks up virtuals in the class's vTable
+	start = Time.get_ticks_usec()
+	for i in INSTANCES:
+		var node = ClassDB.instantiate("BridgeBenchmark")
+		root.add_child(node)
+		root.remove_child(node)
+		node.free()
+	elapsed = Time.get_ticks_usec() - start
+	print("create, add to tree, free: %.1f ns per instance" % (elapsed * 1000.0 / INSTANCES))
+
+	# String returns, one that's always the same and one that never repeats
+	for method in ["literalString", "uniqueString"]:
+		bench.call(method)
+		start = Time.get_ticks_usec()
+		for i in CALLS:
+			bench.call(method)
+		elapsed = Time.get_ticks_usec() - start
+		print("%s: %.1f ns per call" % [method, elapsed * 1000.0 / CALLS])
+
+	# String arguments of 16 to 16M characters, converted to Dart on every call.
+	# Latin-1 and wider text take different paths once strings are large.
+	for chars in ["a", "\u3042"]:
+		var size = 16
+		while size <= 16 * 1024 * 1024:
+			_string_conversion(bench, chars.repeat(size))
+			size *= 16
+
+	bench.free()
+	quit()
+
+func _string_conversion(bench, value: String):
+	# Convert about 64M characters per size, with at least a few calls
+	var calls = clampi(STRING_CHARS / value.length(), 4, CALLS)
+	bench.stringLength(value)
+
+	var start = Time.get_ticks_usec()
+	for i in calls:
+		bench.stringLength(value)
+	var elapsed = Time.get_ticks_usec() - start
+	var ns_per_call = elapsed * 1000.0 / calls
+	print("string U+%04X x %d: %.1f ns per call, %.1f M chars/s" % [
+		value.unicode_at(0), value.length(), ns_per_call,
+		value.length() / ns_per_call * 1000.0])
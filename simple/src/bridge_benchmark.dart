@@ -0,0 +1,69 @@
+import 'dart:ffi';
+
+import 'package:godot_dart/godot_dart.dart';
+
+/// Methods that `benchmark.gd` calls from GDScript to time the bridge. Each
+/// call goes through `bind_call`, so this measures the per call cost of
+/// looking up the method and converting its arguments and return value.
+/// Creating instances and adding them to the tree times the paths that look
+/// up fields and the vTable by name.
+///
+/// Only registered when GODOT_DART_BENCHMARK is set, run with
+/// `GODOT_DART_BENCHMARK=1 godot --headless --path simple --script
+/// benchmark.gd`.
+class BridgeBenchmark extends Node {
+  static late TypeInfo typeInfo;
+  static void initTypeInfo() => typeInfo = TypeInfo(
+        StringName.fromString('BridgeBenchmark'),
+        parentClass: StringName.fromString('Node'),
+      );
+  @pragma('vm:entry-point')
+  static Map<String, Pointer<GodotVirtualFunction>> get vTable => Node.vTable;
+
+  @override
+  TypeInfo get staticTypeInfo => typeInfo;
+
+  @pragma('vm:entry-point')
+  BridgeBenchmark() : super() {
+    postInitialize();
+  }
+
+  static void bind() {
+    initTypeInfo();
+    gde.dartBindings.bindClass(BridgeBenchmark, typeInfo);
+    gde.dartBindings
+        .bindMethod(typeInfo, 'noop', TypeInfo.forType(null)!, []);
+    gde.dartBindings.bindMethod(typeInfo, 'echo', TypeInfo.forType(int)!,
+        [TypeInfo.forType(int)!]);
+    gde.dartBindings.bindMethod(typeInfo, 'stringLength',
+        TypeInfo.forType(int)!, [TypeInfo.forType(String)!]);
+    gde.dartBindings.bindMethod(
+        typeInfo, 'literalString', TypeInfo.forType(String)!, []);
+    gde.dartBindings.bindMethod(
+        typeInfo, 'uniqueString', TypeInfo.forType(String)!, []);
+  }
+
+  var _counter = 0;
+
+  @pragma('vm:entry-point')
+  void noop() {}
+
+  /// Converts an argument to Dart and the result back to a Variant, which
+  /// invokes `_variantsToDart` and `_convertToVariant` by name.
+  @pragma('vm:entry-point')
+  int echo(int value) => value;
+
+  /// Converts [value] from a Godot String on every call.
+  @pragma('vm:entry-point')
+  int stringLength(String value) => value.length;
+
+  /// Returns the same short string every call, which GDString.cached keeps
+  /// converted.
+  @pragma('vm:entry-point')
+  String literalString() => 'health';
+
+  /// Returns a different short string every call, so each one is converted
+  /// and passes through the cache.
+  @pragma('vm:entry-point')
+  String uniqueString() => 'item ${_counter++}';
+}
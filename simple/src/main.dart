@@ -1,9 +1,17 @@
+import 'dart:io';
+
 import 'package:godot_dart/godot_dart.dart';
 
+import 'bridge_benchmark.dart';
 import 'simple.dart';
 
 void main() {
   Simple.initTypeInfo();
 
   gde.dartBindings.bindClass(Simple, Simple.typeInfo);
+
+  // Only needed by benchmark.gd, which is run with GODOT_DART_BENCHMARK set
+  if (Platform.environment.containsKey('GODOT_DART_BENCHMARK')) {
+    BridgeBenchmark.bind();
+  }
 }
@@ -9,6 +9,7 @@ class Simple extends Sprite2D {
         StringName.fromString('Simple'),
         parentClass: StringName.fromString('Sprite2D'),
       );
+  @pragma('vm:entry-point')
   static Map<String, Pointer<GodotVirtualFunction>> get vTable =>
       Sprite2D.vTable;
 
@@ -17,6 +18,7 @@ class Simple extends Sprite2D {
 
   double _timePassed = 0.0;
 
+  @pragma('vm:entry-point')
   Simple() : super() {
     postInitialize();
   }
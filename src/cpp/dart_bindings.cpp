@@ -1,14 +1,21 @@
 #include "dart_bindings.h"
 
+#include <filesystem>
+#include <fstream>
 #include <functional>
+#include <iterator>
 #include <iostream>
+#include <stdlib.h>
 #include <string.h>
+#include <string_view>
 #include <thread>
 
 #include <dart_api.h>
 #include <dart_dll.h>
 #include <godot/gdextension_interface.h>
 
+#include "dart_handle_table.h"
+#include "dart_native_table.h"
 #include "dart_vtable_wrapper.h"
 #include "gde_wrapper.h"
 
@@ -25,10 +32,16 @@ static void *__binding_create_callback(void *p_token, void *p_instance) {
 }
 
 static void __binding_free_callback(void *p_token, void *p_instance, void *p_binding) {
+  // Extension instances share their handle with the binding, it's released in `class_free_instance`
 }
 
-static GDExtensionBool __binding_reference_callback(void *p_token, void *p_instance, GDExtensionBool p_reference) {
-  return true;
+static GDExtensionBool __binding_reference_callback(void *p_token, void *p_binding, GDExtensionBool p_reference) {
+  // The table only records the change, so this doesn't need the Dart thread
+  if (!GodotDartBindings::instance()) {
+    return true;
+  }
+
+  return dart_handle_table::reference(p_binding, p_reference);
 }
 
 static constexpr GDExtensionInstanceBindingCallbacks __binding_callbacks = {
@@ -37,21 +50,154 @@ static constexpr GDExtensionInstanceBindingCallbacks __binding_callbacks = {
     __binding_reference_callback,
 };
 
+// Identifiers used on every call across the bridge. Created once as persistent handles in
+// `initialize` so hot paths don't allocate a new Dart String for each field lookup or invoke.
+struct DartNames {
+  Dart_PersistentHandle opaque;
+  Dart_PersistentHandle address;
+  Dart_PersistentHandle native_ptr;
+  Dart_PersistentHandle v_table;
+  Dart_PersistentHandle class_name;
+  Dart_PersistentHandle parent_class;
+  Dart_PersistentHandle variant_type;
+  Dart_PersistentHandle binding_callbacks;
+  Dart_PersistentHandle variants_to_dart;
+  Dart_PersistentHandle convert_to_variant;
+  Dart_PersistentHandle pool_size;
+  Dart_PersistentHandle reuse_from_pool;
+};
+
+static DartNames __dart_names = {};
+
+#define DART_NAME(name) Dart_HandleFromPersistent(__dart_names.name)
+
+static void create_dart_names() {
+  __dart_names.opaque = Dart_NewPersistentHandle(Dart_NewStringFromCString("_opaque"));
+  __dart_names.address = Dart_NewPersistentHandle(Dart_NewStringFromCString("address"));
+  __dart_names.native_ptr = Dart_NewPersistentHandle(Dart_NewStringFromCString("nativePtr"));
+  __dart_names.v_table = Dart_NewPersistentHandle(Dart_NewStringFromCString("vTable"));
+  __dart_names.class_name = Dart_NewPersistentHandle(Dart_NewStringFromCString("className"));
+  __dart_names.parent_class = Dart_NewPersistentHandle(Dart_NewStringFromCString("parentClass"));
+  __dart_names.variant_type = Dart_NewPersistentHandle(Dart_NewStringFromCString("variantType"));
+  __dart_names.binding_callbacks = Dart_NewPersistentHandle(Dart_NewStringFromCString("bindingCallbacks"));
+  __dart_names.variants_to_dart = Dart_NewPersistentHandle(Dart_NewStringFromCString("_variantsToDart"));
+  __dart_names.convert_to_variant = Dart_NewPersistentHandle(Dart_NewStringFromCString("_convertToVariant"));
+  __dart_names.pool_size = Dart_NewPersistentHandle(Dart_NewStringFromCString("poolSize"));
+  __dart_names.reuse_from_pool = Dart_NewPersistentHandle(Dart_NewStringFromCString("_reuseFromPool"));
+}
+
+static void delete_dart_names() {
+  Dart_PersistentHandle *names = reinterpret_cast<Dart_PersistentHandle *>(&__dart_names);
+  for (size_t i = 0; i < sizeof(DartNames) / sizeof(Dart_PersistentHandle); ++i) {
+    Dart_DeletePersistentHandle(names[i]);
+    names[i] = nullptr;
+  }
+}
+
 struct MethodInfo {
   std::string method_name;
+  Dart_PersistentHandle dart_method_name;
   TypeInfo return_type;
   std::vector<TypeInfo> arguments;
 };
 
+// Class information decoded once in `bind_class` and handed to Godot as the class userdata,
+// so creating instances never has to read the Dart TypeInfo again.
+struct ClassInfo {
+  Dart_PersistentHandle type;
+  // Retains the Dart TypeInfo so the StringNames referenced by type_info stay alive
+  Dart_PersistentHandle dart_type_info;
+  TypeInfo type_info;
+
+  // Instances freed by Godot that are kept for reuse (see TypeInfo.poolSize in Dart)
+  size_t pool_size;
+  std::vector<void *> pool;
+};
+
+// Set while `class_create_instance` constructs a Dart object, so `postInitialize` can use
+// the already decoded TypeInfo instead of fetching it from the new object.
+static ClassInfo *__creating_class_info = nullptr;
+
+// Every class bound from Dart, to tell them apart from engine classes
+static std::vector<ClassInfo *> __bound_classes;
+
+static bool is_bound_class(GDExtensionConstStringNamePtr class_name) {
+  static GDExtensionPtrOperatorEvaluator string_name_equal = GDE->variant_get_ptr_operator_evaluator(
+      GDEXTENSION_VARIANT_OP_EQUAL, GDEXTENSION_VARIANT_TYPE_STRING_NAME, GDEXTENSION_VARIANT_TYPE_STRING_NAME);
+  for (ClassInfo *class_info : __bound_classes) {
+    GDExtensionBool equal = false;
+    string_name_equal(class_info->type_info.type_name, class_name, &equal);
+    if (equal) {
+      return true;
+    }
+  }
+  return false;
+}
+
 GodotDartBindings *GodotDartBindings::_instance = nullptr;
 Dart_NativeFunction native_resolver(Dart_Handle name, int num_of_arguments, bool *auto_setup_scope);
+void *ffi_native_resolver(const char *name, uintptr_t args_n);
+
+#ifdef GODOT_DART_SNAPSHOT_LOADING
+// Reads the kernel file at `path` into `buffer`, checking that it starts with the kernel magic number
+static bool read_kernel(const char *path, std::vector<uint8_t> &buffer) {
+  constexpr uint8_t kKernelMagicNumber[] = {0x90, 0xab, 0xcd, 0xef};
+
+  std::ifstream file(std::filesystem::path(reinterpret_cast<const char8_t *>(path)), std::ios::binary);
+  if (!file) {
+    return false;
+  }
+  buffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+  if (buffer.size() < sizeof(kKernelMagicNumber) ||
+      memcmp(buffer.data(), kKernelMagicNumber, sizeof(kKernelMagicNumber)) != 0) {
+    buffer.clear();
+    return false;
+  }
+  return true;
+}
+#endif
+
+bool GodotDartBindings::initialize(const char *script_path, const char *package_config,
+                                   const char *kernel_path, const char *snapshot_path) {
+  _start_time = std::chrono::steady_clock::now();
 
-bool GodotDartBindings::initialize(const char *script_path, const char *package_config) {
   dart_vtable_wrapper::init_virtual_thunks();
 
   DartDll_Initialize();
 
-  _isolate = DartDll_LoadScript(script_path, package_config);
+#ifdef GODOT_DART_PRECOMPILED_RUNTIME
+  // A precompiled runtime has no kernel service or JIT, `script_path` is the ELF snapshot
+  _isolate = DartDll_LoadAotSnapshot(script_path);
+  _loaded_from = "AOT snapshot";
+#else
+#ifdef GODOT_DART_SNAPSHOT_LOADING
+  // Both create the isolate group straight from the precompiled script instead of starting the
+  // front end to compile it. A snapshot from a different VM build fails to load.
+  if (snapshot_path != nullptr) {
+    _isolate = DartDll_LoadAppJitSnapshot(snapshot_path, script_path, package_config);
+    _loaded_from = "AppJIT snapshot";
+    if (_isolate == nullptr) {
+      GD_PRINT_WARNING("GodotDart: Failed to load the AppJIT snapshot, ignoring it");
+    }
+  }
+  if (_isolate == nullptr && kernel_path != nullptr) {
+    if (!read_kernel(kernel_path, _kernel_buffer)) {
+      GD_PRINT_WARNING("GodotDart: `src/main.dill` is missing or not a kernel file, loading from source");
+    } else {
+      _isolate = DartDll_LoadKernel(script_path, package_config, _kernel_buffer.data(), _kernel_buffer.size());
+      _loaded_from = "kernel";
+      if (_isolate == nullptr) {
+        GD_PRINT_WARNING("GodotDart: Failed to load the precompiled kernel, loading from source");
+        _kernel_buffer.clear();
+      }
+    }
+  }
+#endif
+  if (_isolate == nullptr) {
+    _isolate = DartDll_LoadScript(script_path, package_config);
+    _loaded_from = "source";
+  }
+#endif
   if (_isolate == nullptr) {
     GD_PRINT_ERROR("GodotDart: Initialization Error (Failed to load script)");
     return false;
@@ -60,6 +206,9 @@ bool GodotDartBindings::initialize(const char *script_path, const char *package_
   Dart_EnterIsolate(_isolate);
   Dart_EnterScope();
 
+  create_dart_names();
+  dart_handle_table::initialize();
+
   Dart_Handle godot_dart_package_name = Dart_NewStringFromCString("package:godot_dart/godot_dart.dart");
   Dart_Handle godot_dart_library = Dart_LookupLibrary(godot_dart_package_name);
   if (Dart_IsError(godot_dart_library)) {
@@ -79,17 +228,16 @@ bool GodotDartBindings::initialize(const char *script_path, const char *package_
       // Retrain for future calls to convert variants
       _native_library = Dart_NewPersistentHandle(library);
       Dart_SetNativeResolver(library, native_resolver, nullptr);
+      Dart_SetFfiNativeResolver(library, ffi_native_resolver);
     }
   }
 
-  // Find the DartBindings "library" (just the file) and set us as the native callback handler
+  // Find the core types library, used to hand pooled objects back to Dart
   {
     Dart_Handle native_bindings_library_name = Dart_NewStringFromCString("package:godot_dart/src/core/core_types.dart");
     Dart_Handle library = Dart_LookupLibrary(native_bindings_library_name);
     if (!Dart_IsError(library)) {
-      // Retrain for future calls to convert variants
       _core_types_library = Dart_NewPersistentHandle(library);
-      Dart_SetNativeResolver(library, native_resolver, nullptr);
     }
   }
 
@@ -192,6 +340,11 @@ void GodotDartBindings::shutdown() {
   Dart_EnterIsolate(_isolate);
   Dart_EnterScope();
 
+  // Snapshot while everything the run compiled is still around
+  if (!_training_snapshot_path.empty()) {
+    write_training_snapshot();
+  }
+
   Dart_Handle godot_dart_library = Dart_HandleFromPersistent(_godot_dart_library);
 
   GDEWrapper *wrapper = GDEWrapper::instance();
@@ -204,6 +357,8 @@ void GodotDartBindings::shutdown() {
   Dart_DeletePersistentHandle(_godot_dart_library);
   Dart_DeletePersistentHandle(_core_types_library);
   Dart_DeletePersistentHandle(_native_library);
+  dart_handle_table::shutdown();
+  delete_dart_names();
 
   DartDll_DrainMicrotaskQueue();
   Dart_ExitScope();
@@ -213,6 +368,71 @@ void GodotDartBindings::shutdown() {
   _instance = nullptr;
 }
 
+void GodotDartBindings::report_first_frame() {
+  auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - _start_time);
+  std::string message = "GodotDart: First frame " + std::to_string(elapsed.count()) +
+                        "ms after initialization (loaded from " + _loaded_from +
+                        (_training_snapshot_path.empty() ? ")" : ", training run)");
+
+  // GDExtension has no plain print, so this goes to Godot's output as a warning that doesn't
+  // notify the editor
+  GDE->print_warning(message.c_str(), __func__, __FILE__, __LINE__, false);
+}
+
+// Writes the snapshot in the standalone VM's app snapshot layout, so it can be loaded the same
+// way as one from `dart --snapshot-kind=app-jit`: a magic number and the sizes of the four
+// pieces, followed by the pieces, each aligned to a page. The VM pieces are left empty, the
+// VM's own are used.
+static bool write_app_jit_snapshot(const char *path, const uint8_t *isolate_data, int64_t isolate_data_size,
+                                   const uint8_t *isolate_instructions, int64_t isolate_instructions_size) {
+  constexpr uint8_t kAppJITMagicNumber[] = {0xdc, 0xdc, 0xf6, 0xf6, 0, 0, 0, 0};
+  constexpr int64_t kAppSnapshotPageSize = 16 * 1024;
+
+  std::ofstream file(std::filesystem::path(reinterpret_cast<const char8_t *>(path)), std::ios::binary);
+  if (!file) {
+    return false;
+  }
+
+  auto pad_to_page = [&]() {
+    int64_t position = file.tellp();
+    int64_t aligned = (position + kAppSnapshotPageSize - 1) & ~(kAppSnapshotPageSize - 1);
+    for (; position < aligned; ++position) {
+      file.put(0);
+    }
+  };
+
+  const int64_t header[] = {0, 0, isolate_data_size, isolate_instructions_size};
+  file.write(reinterpret_cast<const char *>(kAppJITMagicNumber), sizeof(kAppJITMagicNumber));
+  file.write(reinterpret_cast<const char *>(header), sizeof(header));
+  pad_to_page();
+  file.write(reinterpret_cast<const char *>(isolate_data), isolate_data_size);
+  if (isolate_instructions_size != 0) {
+    pad_to_page();
+    file.write(reinterpret_cast<const char *>(isolate_instructions), isolate_instructions_size);
+  }
+
+  return file.good();
+}
+
+void GodotDartBindings::write_training_snapshot() {
+  uint8_t *isolate_data = nullptr, *isolate_instructions = nullptr;
+  intptr_t isolate_data_size = 0, isolate_instructions_size = 0;
+  // The snapshot holds the program and the code compiled for it, not the isolate's static
+  // state, so nothing from this run (like native pointers) carries over to the next.
+  Dart_Handle result = Dart_CreateAppJITSnapshotAsBlobs(&isolate_data, &isolate_data_size, &isolate_instructions,
+                                                        &isolate_instructions_size);
+  if (Dart_IsError(result)) {
+    GD_PRINT_ERROR("GodotDart: Error creating the AppJIT snapshot: ");
+    GD_PRINT_ERROR(Dart_GetError(result));
+    return;
+  }
+
+  if (!write_app_jit_snapshot(_training_snapshot_path.c_str(), isolate_data, isolate_data_size,
+                              isolate_instructions, isolate_instructions_size)) {
+    GD_PRINT_ERROR("GodotDart: Error writing the AppJIT snapshot");
+  }
+}
+
 void GodotDartBindings::thread_main() {
 
   Dart_EnterIsolate(_isolate);
@@ -223,6 +443,9 @@ void GodotDartBindings::thread_main() {
     _pendingWork();
     _pendingWork = []() {};
 
+    // Release anything Dart collected while doing the work
+    dart_handle_table::drain_collected();
+
     // Do work
     _done_semaphore.release();
   }
@@ -249,6 +472,7 @@ void GodotDartBindings::bind_method(const TypeInfo &bind_type, const char *metho
                                     const std::vector<TypeInfo> &arg_list) {
   MethodInfo *info = new MethodInfo();
   info->method_name = method_name;
+  info->dart_method_name = Dart_NewPersistentHandle(Dart_NewStringFromCString(method_name));
   info->return_type = ret_type_info;
   info->arguments = arg_list;
 
@@ -285,10 +509,8 @@ void GodotDartBindings::bind_method(const TypeInfo &bind_type, const char *metho
     flags |= GDEXTENSION_METHOD_FLAG_VIRTUAL;
   }
 
-  uint8_t gd_method_name[GD_STRING_NAME_MAX_SIZE];
-  gde->gd_string_name_new(&gd_method_name, method_name);
   GDExtensionClassMethodInfo method_info = {
-      gd_method_name,
+      const_cast<GDExtensionStringNamePtr>(gde->gd_string_name_intern(method_name)),
       info,
       GodotDartBindings::bind_call,
       GodotDartBindings::ptr_call,
@@ -309,31 +531,47 @@ void GodotDartBindings::bind_method(const TypeInfo &bind_type, const char *metho
   delete[] arg_meta_info;
 }
 
-void *get_opaque_address(Dart_Handle variant_handle) {
-  // TODO: Look for a better way convert the variant.
-  Dart_Handle opaque = Dart_GetField(variant_handle, Dart_NewStringFromCString("_opaque"));
-  if (Dart_IsError(opaque)) {
-    GD_PRINT_ERROR(Dart_GetError(opaque));
+// BuiltinType and ExtensionType are NativeFieldWrapperClass1s. Their native pointer is kept in
+// native field 0 so we can read it without invoking any Dart getters. If it hasn't been stored
+// yet, read it from `pointer_field` once and cache it.
+void *get_native_pointer(Dart_Handle object, Dart_Handle pointer_field) {
+  intptr_t cached = 0;
+  Dart_Handle result = Dart_GetNativeInstanceField(object, 0, &cached);
+  if (!Dart_IsError(result) && cached != 0) {
+    return reinterpret_cast<void *>(cached);
+  }
+
+  Dart_Handle pointer = Dart_GetField(object, pointer_field);
+  if (Dart_IsError(pointer)) {
+    GD_PRINT_ERROR(Dart_GetError(pointer));
     return nullptr;
   }
-  Dart_Handle address = Dart_GetField(opaque, Dart_NewStringFromCString("address"));
+  Dart_Handle address = Dart_GetField(pointer, DART_NAME(address));
   if (Dart_IsError(address)) {
     GD_PRINT_ERROR(Dart_GetError(address));
     return nullptr;
   }
-  uint64_t variantDataPtr = 0;
-  Dart_IntegerToUint64(address, &variantDataPtr);
+  uint64_t native_ptr = 0;
+  Dart_IntegerToUint64(address, &native_ptr);
+
+  if (!Dart_IsError(result)) {
+    Dart_SetNativeInstanceField(object, 0, static_cast<intptr_t>(native_ptr));
+  }
 
-  return reinterpret_cast<void *>(variantDataPtr);
+  return reinterpret_cast<void *>(native_ptr);
+}
+
+void *get_opaque_address(Dart_Handle variant_handle) {
+  return get_native_pointer(variant_handle, DART_NAME(opaque));
 }
 
 void type_info_from_dart(TypeInfo *type_info, Dart_Handle dart_type_info) {
   Dart_EnterScope();
 
-  Dart_Handle class_name = Dart_GetField(dart_type_info, Dart_NewStringFromCString("className"));
-  Dart_Handle parent_class = Dart_GetField(dart_type_info, Dart_NewStringFromCString("parentClass"));
-  Dart_Handle variant_type = Dart_GetField(dart_type_info, Dart_NewStringFromCString("variantType"));
-  Dart_Handle bindings_ptr = Dart_GetField(dart_type_info, Dart_NewStringFromCString("bindingCallbacks"));
+  Dart_Handle class_name = Dart_GetField(dart_type_info, DART_NAME(class_name));
+  Dart_Handle parent_class = Dart_GetField(dart_type_info, DART_NAME(parent_class));
+  Dart_Handle variant_type = Dart_GetField(dart_type_info, DART_NAME(variant_type));
+  Dart_Handle bindings_ptr = Dart_GetField(dart_type_info, DART_NAME(binding_callbacks));
 
   type_info->type_name = get_opaque_address(class_name);
   if (Dart_IsNull(parent_class)) {
@@ -347,7 +585,7 @@ void type_info_from_dart(TypeInfo *type_info, Dart_Handle dart_type_info) {
   if (Dart_IsNull(bindings_ptr)) {
     type_info->binding_callbacks = nullptr;
   } else {
-    Dart_Handle bindings_address = Dart_GetField(bindings_ptr, Dart_NewStringFromCString("address"));
+    Dart_Handle bindings_address = Dart_GetField(bindings_ptr, DART_NAME(address));
     if (Dart_IsError(bindings_address)) {
       GD_PRINT_ERROR(Dart_GetError(bindings_address));
       type_info->binding_callbacks = nullptr;
@@ -375,44 +613,33 @@ void GodotDartBindings::bind_call(void *method_userdata, GDExtensionClassInstanc
   bindings->execute_on_dart_thread([&]() {
     Dart_EnterScope();
 
-    Dart_PersistentHandle persist_handle = reinterpret_cast<Dart_PersistentHandle>(instance);
-    Dart_Handle dart_instance = Dart_HandleFromPersistent(persist_handle);
+    Dart_Handle dart_instance = dart_handle_table::get(instance);
 
     MethodInfo *method_info = reinterpret_cast<MethodInfo *>(method_userdata);
-    Dart_Handle dart_method_name = Dart_NewStringFromCString(method_info->method_name.c_str());
+    Dart_Handle dart_method_name = Dart_HandleFromPersistent(method_info->dart_method_name);
 
     Dart_Handle *dart_args = nullptr;
     if (method_info->arguments.size() > 0) {
       // First convert to Dart values
-      // Get all the bindings callbacks for the requested parameters
-      Dart_Handle dart_bindings_list =
-          Dart_NewListOfTypeFilled(bindings->_void_pointer_optional_type, Dart_Null(), method_info->arguments.size());
+      // Get all the bindings callbacks for the requested parameters. Addresses are passed as
+      // integers and Dart makes the Pointers, as AOT doesn't keep dart:ffi's constructors around
+      // for Dart_New.
+      Dart_Handle dart_bindings_list = Dart_NewList(method_info->arguments.size());
       for (size_t i = 0; i < method_info->arguments.size(); ++i) {
         const TypeInfo &arg_info = method_info->arguments[i];
         if (arg_info.binding_callbacks != nullptr) {
-          Dart_Handle callbacks_address = Dart_NewInteger(reinterpret_cast<intptr_t>(args));
-          Dart_Handle callbacks_ptr = Dart_New(Dart_HandleFromPersistent(bindings->_void_pointer_pointer_type),
-                                               Dart_NewStringFromCString("fromAddress"), 1, &callbacks_address);
-          Dart_ListSetAt(dart_bindings_list, i, callbacks_ptr);
+          Dart_ListSetAt(dart_bindings_list, i,
+                         Dart_NewInteger(reinterpret_cast<intptr_t>(arg_info.binding_callbacks)));
         }
       }
 
-      Dart_Handle args_address = Dart_NewInteger(reinterpret_cast<intptr_t>(args));
       Dart_Handle convert_args[3]{
-          Dart_New(Dart_HandleFromPersistent(bindings->_void_pointer_pointer_type),
-                   Dart_NewStringFromCString("fromAddress"), 1, &args_address),
+          Dart_NewInteger(reinterpret_cast<intptr_t>(args)),
           Dart_NewInteger(method_info->arguments.size()),
           dart_bindings_list,
       };
-      if (Dart_IsError(convert_args[0])) {
-        GD_PRINT_ERROR("GodotDart: Error creating parameters: ");
-        GD_PRINT_ERROR(Dart_GetError(convert_args[0]));
-
-        Dart_ExitScope();
-        return;
-      }
       Dart_Handle dart_arg_list =
-          Dart_Invoke(bindings->_native_library, Dart_NewStringFromCString("_variantsToDart"), 3, convert_args);
+          Dart_Invoke(bindings->_native_library, DART_NAME(variants_to_dart), 3, convert_args);
       if (Dart_IsError(dart_arg_list)) {
         GD_PRINT_ERROR("GodotDart: Error converting parameters from Variants: ");
         GD_PRINT_ERROR(Dart_GetError(dart_arg_list));
@@ -436,7 +663,7 @@ void GodotDartBindings::bind_call(void *method_userdata, GDExtensionClassInstanc
       // the logic and type checking is easier in Dart.
       Dart_Handle native_library = Dart_HandleFromPersistent(bindings->_native_library);
       Dart_Handle args[] = {result};
-      Dart_Handle variant_result = Dart_Invoke(native_library, Dart_NewStringFromCString("_convertToVariant"), 1, args);
+      Dart_Handle variant_result = Dart_Invoke(native_library, DART_NAME(convert_to_variant), 1, args);
       if (Dart_IsError(variant_result)) {
         GD_PRINT_ERROR("GodotDart: Error converting return to variant: ");
         GD_PRINT_ERROR(Dart_GetError(result));
@@ -485,9 +712,10 @@ GDExtensionClassCallVirtual GodotDartBindings::get_virtual_func(void *p_userdata
   bindings->execute_on_dart_thread([&]() {
     Dart_EnterScope();
 
-    Dart_Handle type = Dart_HandleFromPersistent(reinterpret_cast<Dart_PersistentHandle>(p_userdata));
+    ClassInfo *class_info = reinterpret_cast<ClassInfo *>(p_userdata);
+    Dart_Handle type = Dart_HandleFromPersistent(class_info->type);
 
-    Dart_Handle vtable = Dart_GetField(type, Dart_NewStringFromCString("vTable"));
+    Dart_Handle vtable = Dart_GetField(type, DART_NAME(v_table));
     if (Dart_IsError(vtable)) {
       GD_PRINT_ERROR("GodotDart: Error finding typeInfo on object: ");
       GD_PRINT_ERROR(Dart_GetError(vtable));
@@ -512,6 +740,10 @@ GDExtensionClassCallVirtual GodotDartBindings::get_virtual_func(void *p_userdata
 
     gde->gd_string_destructor(gd_string);
 
+    // Virtuals Godot calls every frame also report the time to the first frame
+    std::u16string_view name(temp, length);
+    bool is_frame_callback = name == u"_process" || name == u"_physics_process";
+
     Dart_Handle dart_string = Dart_NewStringFromUTF16((uint16_t *)temp, length);
     if (Dart_IsError(dart_string)) {
       GD_PRINT_ERROR("GodotDart: Error conveting StringName to Dart String: ");
@@ -533,12 +765,13 @@ GDExtensionClassCallVirtual GodotDartBindings::get_virtual_func(void *p_userdata
       return;
     }
 
-    Dart_Handle dart_address = Dart_GetField(vtable_item, Dart_NewStringFromCString("address"));
+    Dart_Handle dart_address = Dart_GetField(vtable_item, DART_NAME(address));
 
     uint64_t address = 0;
     Dart_IntegerToUint64(dart_address, &address);
 
-    func = dart_vtable_wrapper::get_wrapped_virtual(reinterpret_cast<GDExtensionClassCallVirtual>(address));
+    func = dart_vtable_wrapper::get_wrapped_virtual(reinterpret_cast<GDExtensionClassCallVirtual>(address),
+                                                    is_frame_callback);
 
     Dart_ExitScope();
   });
@@ -557,19 +790,48 @@ GDExtensionObjectPtr GodotDartBindings::class_create_instance(void *p_userdata)
   bindings->execute_on_dart_thread([&]() {
     Dart_EnterScope();
 
-    Dart_Handle type = Dart_HandleFromPersistent(reinterpret_cast<Dart_PersistentHandle>(p_userdata));
+    ClassInfo *class_info = reinterpret_cast<ClassInfo *>(p_userdata);
+
+    // Pooled classes reuse a freed Dart instance (and its handle) by giving it a new owner
+    while (!class_info->pool.empty()) {
+      void *handle = class_info->pool.back();
+      class_info->pool.pop_back();
+
+      GDExtensionObjectPtr owner = GDE->classdb_construct_object(class_info->type_info.parent_name);
+      if (owner == nullptr) {
+        dart_handle_table::free_handle(handle);
+        break;
+      }
+
+      Dart_Handle pooled_object = dart_handle_table::get(handle);
+      Dart_SetNativeInstanceField(pooled_object, 0, reinterpret_cast<intptr_t>(owner));
+      Dart_Handle reuse_args[] = {pooled_object, Dart_NewInteger(reinterpret_cast<intptr_t>(owner))};
+      Dart_Handle result = Dart_Invoke(Dart_HandleFromPersistent(bindings->_core_types_library),
+                                       DART_NAME(reuse_from_pool), 2, reuse_args);
+      if (Dart_IsError(result)) {
+        GD_PRINT_ERROR("GodotDart: Error reusing pooled object: ");
+        GD_PRINT_ERROR(Dart_GetError(result));
+        dart_handle_table::free_handle(handle);
+        GDE->object_destroy(owner);
+        continue;
+      }
+
+      GDE->object_set_instance(owner, class_info->type_info.type_name,
+                               reinterpret_cast<GDExtensionClassInstancePtr>(handle));
+      GDE->object_set_instance_binding(owner, GDEWrapper::instance()->lib(), handle, &__binding_callbacks);
+      dart_handle_table::hold_reference(handle, owner);
+      real_address = reinterpret_cast<uint64_t>(owner);
 
-    Dart_Handle d_class_type_info = Dart_GetField(type, Dart_NewStringFromCString("typeInfo"));
-    if (Dart_IsError(d_class_type_info)) {
-      GD_PRINT_ERROR("GodotDart: Error finding typeInfo on object: ");
-      GD_PRINT_ERROR(Dart_GetError(d_class_type_info));
       Dart_ExitScope();
       return;
     }
-    TypeInfo class_type_info;
-    type_info_from_dart(&class_type_info, d_class_type_info);
 
+    Dart_Handle type = Dart_HandleFromPersistent(class_info->type);
+
+    ClassInfo *outer_class_info = __creating_class_info;
+    __creating_class_info = class_info;
     Dart_Handle new_object = Dart_New(type, Dart_Null(), 0, nullptr);
+    __creating_class_info = outer_class_info;
     if (Dart_IsError(new_object)) {
       GD_PRINT_ERROR("GodotDart: Error creating object: ");
       GD_PRINT_ERROR(Dart_GetError(new_object));
@@ -577,23 +839,8 @@ GDExtensionObjectPtr GodotDartBindings::class_create_instance(void *p_userdata)
       return;
     }
 
-    Dart_Handle owner = Dart_GetField(new_object, Dart_NewStringFromCString("nativePtr"));
-    if (Dart_IsError(owner)) {
-      GD_PRINT_ERROR("GodotDart: Error finding owner member for object: ");
-      GD_PRINT_ERROR(Dart_GetError(owner));
-      Dart_ExitScope();
-      return;
-    }
-
-    Dart_Handle owner_address = Dart_GetField(owner, Dart_NewStringFromCString("address"));
-    if (Dart_IsError(owner_address)) {
-      GD_PRINT_ERROR("GodotDart: Error getting address for object: ");
-      GD_PRINT_ERROR(Dart_GetError(owner_address));
-      Dart_ExitScope();
-      return;
-    }
-
-    Dart_IntegerToUint64(owner_address, &real_address);
+    // `postInitialize` stored the owner in the object's native field
+    real_address = reinterpret_cast<uint64_t>(get_native_pointer(new_object, DART_NAME(native_ptr)));
 
     Dart_ExitScope();
   });
@@ -608,8 +855,14 @@ void GodotDartBindings::class_free_instance(void *p_userdata, GDExtensionClassIn
     return;
   }
 
-  bindings->execute_on_dart_thread(
-      [&]() { Dart_DeletePersistentHandle(reinterpret_cast<Dart_PersistentHandle>(p_instance)); });
+  bindings->execute_on_dart_thread([&]() {
+    ClassInfo *class_info = reinterpret_cast<ClassInfo *>(p_userdata);
+    if (class_info->pool.size() < class_info->pool_size && dart_handle_table::detach(p_instance)) {
+      class_info->pool.push_back(p_instance);
+    } else {
+      dart_handle_table::free_handle(p_instance);
+    }
+  });
 }
 
 /* Static Functions From Dart */
@@ -624,30 +877,43 @@ void bind_class(Dart_NativeArguments args) {
   Dart_Handle type_arg = Dart_GetNativeArgument(args, 1);
   Dart_Handle type_info = Dart_GetNativeArgument(args, 2);
 
-  // Name and Parent are StringNames and we can get their opaque addresses
-  Dart_Handle name = Dart_GetField(type_info, Dart_NewStringFromCString("className"));
-  Dart_Handle parent = Dart_GetField(type_info, Dart_NewStringFromCString("parentClass"));
+  Dart_Handle parent = Dart_GetField(type_info, DART_NAME(parent_class));
   if (Dart_IsNull(parent)) {
     Dart_ThrowException(Dart_NewStringFromCString("Passed null reference for parent in bindClass."));
     return;
   }
 
-  void *sn_name = get_opaque_address(name);
-  if (sn_name == nullptr) {
+  // Decode the TypeInfo once. Name and Parent are StringNames and we hold their opaque addresses
+  ClassInfo *class_info = new ClassInfo();
+  type_info_from_dart(&class_info->type_info, type_info);
+  if (class_info->type_info.type_name == nullptr || class_info->type_info.parent_name == nullptr) {
+    delete class_info;
     return;
   }
-  void *sn_parent = get_opaque_address(parent);
-  if (sn_parent == nullptr) {
-    return;
+  class_info->type = Dart_NewPersistentHandle(type_arg);
+  class_info->dart_type_info = Dart_NewPersistentHandle(type_info);
+
+  int64_t pool_size = 0;
+  Dart_IntegerToInt64(Dart_GetField(type_info, DART_NAME(pool_size)), &pool_size);
+  class_info->pool_size = pool_size > 0 ? static_cast<size_t>(pool_size) : 0;
+  // Reuse constructs a new owner of the parent class, which only gives an object without a Dart
+  // instance of its own if the parent is an engine class
+  if (class_info->pool_size > 0 && is_bound_class(class_info->type_info.parent_name)) {
+    GD_PRINT_WARNING("GodotDart: Pooling is only supported for classes whose parent is an engine class. "
+                     "Pooling is disabled for this class.");
+    class_info->pool_size = 0;
   }
+  class_info->pool.reserve(class_info->pool_size);
 
   GDExtensionClassCreationInfo info = {0};
-  info.class_userdata = (void *)Dart_NewPersistentHandle(type_arg);
+  info.class_userdata = (void *)class_info;
   info.create_instance_func = GodotDartBindings::class_create_instance;
   info.free_instance_func = GodotDartBindings::class_free_instance;
   info.get_virtual_func = GodotDartBindings::get_virtual_func;
 
-  GDE->classdb_register_extension_class(GDEWrapper::instance()->lib(), sn_name, sn_parent, &info);
+  GDE->classdb_register_extension_class(GDEWrapper::instance()->lib(), class_info->type_info.type_name,
+                                        class_info->type_info.parent_name, &info);
+  __bound_classes.push_back(class_info);
 }
 
 void bind_method(Dart_NativeArguments args) {
@@ -687,144 +953,318 @@ void bind_method(Dart_NativeArguments args) {
   bindings->bind_method(bind_type_info, method_name, return_type_info, argument_list);
 }
 
-void gd_string_to_dart_string(Dart_NativeArguments args) {
-  GodotDartBindings *bindings = GodotDartBindings::instance();
-  if (!bindings) {
-    Dart_ThrowException(Dart_NewStringFromCString("GodotDart has been shutdown!"));
-    return;
+// Strings at least this long (in characters) are handed to Dart as external strings so their
+// contents stay out of the Dart heap.
+static constexpr GDExtensionInt kExternalStringThreshold = 64 * 1024;
+
+static void __free_external_string(void *isolate_callback_data, void *peer) {
+  free(peer);
+}
+
+static Dart_Handle __new_external_string(const char32_t *chars, GDExtensionInt length) {
+  bool is_latin1 = true;
+  for (GDExtensionInt i = 0; i < length && is_latin1; ++i) {
+    is_latin1 = chars[i] <= 0xFF;
   }
 
-  Dart_Handle dart_gd_string = Dart_GetNativeArgument(args, 1);
-  GDExtensionConstStringPtr gd_string = get_opaque_address(dart_gd_string);
+  if (is_latin1) {
+    uint8_t *latin1 = reinterpret_cast<uint8_t *>(malloc(length));
+    if (latin1 == nullptr) {
+      return Dart_NewApiError("GodotDart: Failed to allocate string");
+    }
+    for (GDExtensionInt i = 0; i < length; ++i) {
+      latin1[i] = static_cast<uint8_t>(chars[i]);
+    }
 
-  char16_t length = GDE->string_to_utf16_chars(gd_string, nullptr, 0);
-  char16_t *temp = (char16_t *)_alloca(sizeof(char16_t) * (length + 1));
-  GDE->string_to_utf16_chars(gd_string, temp, length);
-  temp[length] = 0;
+    return Dart_NewExternalLatin1String(latin1, length, latin1, length, __free_external_string);
+  }
 
-  Dart_Handle dart_string = Dart_NewStringFromUTF16((uint16_t *)temp, length);
-  if (Dart_IsError(dart_string)) {
-    Dart_ThrowException(Dart_NewStringFromCString(Dart_GetError(dart_string)));
-    return;
+  // Characters outside the BMP take a surrogate pair, so this may need up to twice the length
+  uint16_t *utf16 = reinterpret_cast<uint16_t *>(malloc(sizeof(uint16_t) * length * 2));
+  if (utf16 == nullptr) {
+    return Dart_NewApiError("GodotDart: Failed to allocate string");
+  }
+  intptr_t utf16_length = 0;
+  for (GDExtensionInt i = 0; i < length; ++i) {
+    char32_t c = chars[i];
+    if (c > 0xFFFF) {
+      c -= 0x10000;
+      utf16[utf16_length++] = static_cast<uint16_t>(0xD800 + (c >> 10));
+      utf16[utf16_length++] = static_cast<uint16_t>(0xDC00 + (c & 0x3FF));
+    } else {
+      utf16[utf16_length++] = static_cast<uint16_t>(c);
+    }
   }
 
-  Dart_SetReturnValue(args, dart_string);
+  return Dart_NewExternalUTF16String(utf16, utf16_length, utf16, sizeof(uint16_t) * length * 2,
+                                     __free_external_string);
 }
 
-void gd_object_to_dart_object(Dart_NativeArguments args) {
-  GodotDartBindings *bindings = GodotDartBindings::instance();
-  if (!bindings) {
-    Dart_ThrowException(Dart_NewStringFromCString("GodotDart has been shutdown!"));
-    return;
+// Strings up to this many characters are converted through a stack buffer
+static constexpr intptr_t kStackStringLength = 256;
+
+struct DartNativeEntry {
+  const char *name;
+  Dart_NativeFunction function;
+  // Including the receiver for instance methods
+  int argument_count;
+  bool auto_setup_scope;
+};
+
+static constexpr DartNativeEntry kDartNatives[] = {
+    {"GodotDartNativeBindings::bindMethod", bind_method, 5, true},
+    {"GodotDartNativeBindings::bindClass", bind_class, 3, true},
+};
+
+static constexpr NativeNameTable<DartNativeEntry, std::size(kDartNatives), 2> kDartNativeTable(kDartNatives);
+static_assert(kDartNativeTable.is_perfect(), "No perfect hash seed found for kDartNatives");
+
+// Longest native name we resolve, including the terminator
+static constexpr intptr_t kMaxNativeNameLength = 128;
+
+Dart_NativeFunction native_resolver(Dart_Handle name, int num_of_arguments, bool *auto_setup_scope) {
+  // Copy the name into a stack buffer, this doesn't need a scope or a zone allocation
+  char c_name[kMaxNativeNameLength];
+  intptr_t length = 0;
+  if (Dart_IsError(Dart_StringLength(name, &length)) || length >= kMaxNativeNameLength) {
+    return nullptr;
+  }
+  if (Dart_IsError(Dart_StringToLatin1(name, reinterpret_cast<uint8_t *>(c_name), &length))) {
+    return nullptr;
   }
+  c_name[length] = '\0';
 
-  Dart_Handle dart_gd_object = Dart_GetNativeArgument(args, 1);
-  Dart_Handle address = Dart_GetField(dart_gd_object, Dart_NewStringFromCString("address"));
-  if (Dart_IsError(address)) {
-    GD_PRINT_ERROR(Dart_GetError(address));
-    Dart_ThrowException(Dart_NewStringFromCString(Dart_GetError(address)));
-    return;
+  const DartNativeEntry *entry = kDartNativeTable.find(c_name);
+  if (entry == nullptr || entry->argument_count != num_of_arguments) {
+    return nullptr;
   }
-  uint64_t object_ptr = 0;
-  Dart_IntegerToUint64(address, &object_ptr);
 
-  Dart_Handle dart_bindings_ptr = Dart_GetNativeArgument(args, 2);
-  const GDExtensionInstanceBindingCallbacks *bindings_callbacks = &__binding_callbacks;
-  if (!Dart_IsNull(dart_bindings_ptr)) {
-    address = Dart_GetField(dart_bindings_ptr, Dart_NewStringFromCString("address"));
-    if (Dart_IsError(address)) {
-      GD_PRINT_ERROR(Dart_GetError(address));
-      Dart_ThrowException(Dart_NewStringFromCString(Dart_GetError(address)));
-      return;
-    }
-    uint64_t bindings_ptr = 0;
-    Dart_IntegerToUint64(address, &bindings_ptr);
-    bindings_callbacks = reinterpret_cast<const GDExtensionInstanceBindingCallbacks *>(bindings_ptr);
+  *auto_setup_scope = entry->auto_setup_scope;
+  return entry->function;
+}
+
+extern "C" {
+
+GDE_EXPORT void variant_copy(void *dest, void *src, int size) {
+  memcpy(dest, src, size);
+}
+
+// Copy the interned StringName for `hash` into `out`. If `cstr` is null this only looks up the
+// name, otherwise the name is interned if needed. Returns false if nothing was copied.
+GDE_EXPORT bool godot_dart_copy_interned_string_name(uint64_t hash, const char *cstr, void *out) {
+  GDEWrapper *gde = GDEWrapper::instance();
+  GDExtensionConstStringNamePtr interned =
+      cstr == nullptr ? gde->gd_string_name_lookup(hash) : gde->gd_string_name_intern(hash, cstr);
+  if (interned == nullptr) {
+    return false;
   }
 
+  gde->gd_string_name_copy(out, interned);
+  return true;
+}
+
+// Intern `count` names at once, writing a pointer to each interned StringName to `out`. The
+// StringNames stay owned by GDEWrapper, so Dart wraps them without copying or destroying them.
+// Used to build the GodotNames table at startup with one call.
+GDE_EXPORT void godot_dart_intern_string_names(const char *const *names, const uint64_t *hashes, size_t count,
+                                               GDExtensionConstStringNamePtr *out) {
   GDEWrapper *gde = GDEWrapper::instance();
-  Dart_PersistentHandle dart_persistent = (Dart_PersistentHandle)GDE->object_get_instance_binding(
-      reinterpret_cast<GDExtensionObjectPtr>(object_ptr), gde->lib(), bindings_callbacks);
-  if (dart_persistent == nullptr) {
-    Dart_SetReturnValue(args, Dart_Null());
+  for (size_t i = 0; i < count; ++i) {
+    out[i] = gde->gd_string_name_keep(hashes[i], names[i]);
+  }
+}
+
+GDE_EXPORT void *godot_dart_new_instance_handle(Dart_Handle object) {
+  return dart_handle_table::new_handle(object);
+}
+
+GDE_EXPORT Dart_Handle godot_dart_get_instance_handle(void *handle) {
+  return dart_handle_table::get(handle);
+}
+
+// The conversion functions below are called through FFI (see kFfiNatives) rather than the
+// Dart_NativeArguments ABI. Those that take or return Dart objects run inside the scope FFI sets
+// up for Handle calls, and report failures by returning an error handle, which FFI rethrows.
+
+GDE_EXPORT Dart_Handle godot_dart_gd_string_to_string(GDExtensionConstStringPtr gd_string) {
+  // Read Godot's UTF-32 buffer in place instead of converting it to a temporary UTF-16 copy.
+  GDExtensionInt length = GDE->string_to_utf32_chars(gd_string, nullptr, 0);
+  if (length == 0) {
+    return Dart_EmptyString();
+  }
+
+  const char32_t *chars = GDE->string_operator_index_const(gd_string, 0);
+  if (length >= kExternalStringThreshold) {
+    return __new_external_string(chars, length);
+  }
+
+  // The VM picks a one byte representation for Latin-1 content on its own
+  return Dart_NewStringFromUTF32(reinterpret_cast<const int32_t *>(chars), length);
+}
+
+GDE_EXPORT Dart_Handle godot_dart_string_to_gd_string(Dart_Handle dart_string, GDExtensionStringPtr dest) {
+  // Copy the string out in the VM's own representation (Latin-1 or UTF-16) so Godot can build its
+  // String in one step, instead of encoding to UTF-8 first.
+  intptr_t char_size = 0;
+  intptr_t length = 0;
+  void *peer = nullptr;
+  Dart_Handle result = Dart_StringGetProperties(dart_string, &char_size, &length, &peer);
+  if (Dart_IsError(result)) {
+    return result;
+  }
+
+  uint16_t stack_buffer[kStackStringLength];
+  void *buffer = stack_buffer;
+  if (length > kStackStringLength) {
+    buffer = malloc(sizeof(uint16_t) * length);
+    if (buffer == nullptr) {
+      return Dart_NewApiError("GodotDart: Failed to allocate string");
+    }
+  }
+
+  if (char_size == 1) {
+    result = Dart_StringToLatin1(dart_string, reinterpret_cast<uint8_t *>(buffer), &length);
+    if (!Dart_IsError(result)) {
+      GDE->string_new_with_latin1_chars_and_len(dest, reinterpret_cast<const char *>(buffer), length);
+    }
   } else {
-    Dart_Handle obj = Dart_HandleFromPersistent(dart_persistent);
-    if (Dart_IsError(obj)) {
-      GD_PRINT_ERROR(Dart_GetError(obj));
-      Dart_ThrowException(Dart_NewStringFromCString(Dart_GetError(address)));
-      return;
+    result = Dart_StringToUTF16(dart_string, reinterpret_cast<uint16_t *>(buffer), &length);
+    if (!Dart_IsError(result)) {
+      GDE->string_new_with_utf16_chars_and_len(dest, reinterpret_cast<const char16_t *>(buffer), length);
     }
-    Dart_SetReturnValue(args, obj);
   }
-}
 
-void dart_object_post_initialize(Dart_NativeArguments args) {
-  Dart_Handle dart_self = Dart_GetNativeArgument(args, 0);
-  Dart_Handle d_class_type_info = Dart_GetField(dart_self, Dart_NewStringFromCString("staticTypeInfo"));
-  if (Dart_IsError(d_class_type_info)) {
-    GD_PRINT_ERROR("GodotDart: Error finding typeInfo on object: ");
-    GD_PRINT_ERROR(Dart_GetError(d_class_type_info));
+  if (buffer != stack_buffer) {
+    free(buffer);
   }
 
-  TypeInfo class_type_info;
-  type_info_from_dart(&class_type_info, d_class_type_info);
+  return result;
+}
 
-  Dart_Handle owner = Dart_GetField(dart_self, Dart_NewStringFromCString("nativePtr"));
-  if (Dart_IsError(owner)) {
-    GD_PRINT_ERROR("GodotDart: Error finding owner member for object: ");
-    GD_PRINT_ERROR(Dart_GetError(owner));
+static void *__object_binding(GDExtensionObjectPtr object, const GDExtensionInstanceBindingCallbacks *callbacks) {
+  if (object == nullptr) {
+    return nullptr;
+  }
+  if (callbacks == nullptr) {
+    callbacks = &__binding_callbacks;
   }
 
-  Dart_Handle owner_address = Dart_GetField(owner, Dart_NewStringFromCString("address"));
-  if (Dart_IsError(owner_address)) {
-    GD_PRINT_ERROR("GodotDart: Error getting address for object: ");
-    GD_PRINT_ERROR(Dart_GetError(owner_address));
+  void *handle = GDE->object_get_instance_binding(object, GDEWrapper::instance()->lib(), callbacks);
+  if (handle != nullptr) {
+    // Bindings created by the Dart create callback can't take their reference until Godot has stored them
+    dart_handle_table::hold_reference(handle, object);
   }
 
-  Dart_PersistentHandle persistent_handle = Dart_NewPersistentHandle(dart_self);
-  GDEWrapper *gde = GDEWrapper::instance();
+  return handle;
+}
 
-  uint64_t real_address = 0;
-  Dart_IntegerToUint64(owner_address, &real_address);
+GDE_EXPORT Dart_Handle godot_dart_gd_object_to_dart_object(GDExtensionObjectPtr object,
+                                                           const GDExtensionInstanceBindingCallbacks *callbacks) {
+  void *handle = __object_binding(object, callbacks);
+  return handle == nullptr ? Dart_Null() : dart_handle_table::get(handle);
+}
 
-  GDE->object_set_instance(reinterpret_cast<GDExtensionObjectPtr>(real_address), class_type_info.type_name,
-                           reinterpret_cast<GDExtensionClassInstancePtr>(persistent_handle));
-  GDE->object_set_instance_binding(reinterpret_cast<GDExtensionObjectPtr>(real_address), gde->lib(), persistent_handle,
-                                   &__binding_callbacks);
+// Same as godot_dart_gd_object_to_dart_object for a RefCounted `object` that came with a reference
+// the caller owns, such as a Ref returned from a ptrcall. That reference is released once the
+// handle table holds its own.
+GDE_EXPORT Dart_Handle godot_dart_ref_to_dart_object(GDExtensionObjectPtr object,
+                                                     const GDExtensionInstanceBindingCallbacks *callbacks) {
+  void *handle = __object_binding(object, callbacks);
+  if (handle == nullptr) {
+    return Dart_Null();
+  }
+
+  Dart_Handle dart_object = dart_handle_table::get(handle);
+  dart_handle_table::release_extra_reference(handle);
+  return dart_object;
 }
 
-Dart_NativeFunction native_resolver(Dart_Handle name, int num_of_arguments, bool *auto_setup_scope) {
-  Dart_EnterScope();
+GDE_EXPORT Dart_Handle godot_dart_post_initialize(Dart_Handle dart_self, GDExtensionObjectPtr owner,
+                                                  GDExtensionConstStringNamePtr type_name) {
+  if (owner == nullptr) {
+    return Dart_NewApiError("GodotDart: Error getting owner address for object");
+  }
+
+  // Objects created by Godot through `class_create_instance` are tracked so the handle stays strong
+  // until Godot takes its first reference.
+  ClassInfo *class_info = __creating_class_info;
+  bool created_by_godot = false;
+  if (class_info != nullptr &&
+      Dart_IdentityEquals(Dart_InstanceGetType(dart_self), Dart_HandleFromPersistent(class_info->type))) {
+    __creating_class_info = nullptr;
+    created_by_godot = true;
+  }
 
-  const char *c_name = nullptr;
-  Dart_StringToCString(name, &c_name);
+  // Cache the owner in the native field, `class_create_instance` reads it from there
+  Dart_SetNativeInstanceField(dart_self, 0, reinterpret_cast<intptr_t>(owner));
+
+  void *handle = dart_handle_table::new_handle(dart_self);
+  GDE->object_set_instance(owner, type_name, reinterpret_cast<GDExtensionClassInstancePtr>(handle));
+  GDE->object_set_instance_binding(owner, GDEWrapper::instance()->lib(), handle, &__binding_callbacks);
+  dart_handle_table::hold_reference(handle, owner);
+  if (!created_by_godot) {
+    // Nothing else references a RefCounted object constructed from Dart yet, so only hold it
+    // weakly until Godot takes a reference.
+    dart_handle_table::update_reference(handle);
+  }
 
-  Dart_NativeFunction ret = nullptr;
+  return Dart_Null();
+}
 
-  if (0 == strcmp(c_name, "GodotDartNativeBindings::bindMethod")) {
-    *auto_setup_scope = true;
-    ret = bind_method;
-  } else if (0 == strcmp(c_name, "GodotDartNativeBindings::bindClass")) {
-    *auto_setup_scope = true;
-    ret = bind_class;
-  } else if (0 == strcmp(c_name, "GodotDartNativeBindings::gdStringToString")) {
-    *auto_setup_scope = true;
-    ret = gd_string_to_dart_string;
-  } else if (0 == strcmp(c_name, "GodotDartNativeBindings::gdObjectToDartObject")) {
-    *auto_setup_scope = true;
-    ret = gd_object_to_dart_object;
-  } else if (0 == strcmp(c_name, "ExtensionType::postInitialize")) {
-    *auto_setup_scope = true;
-    ret = dart_object_post_initialize;
+GDE_EXPORT void godot_dart_binding_free_callback(void *p_token, void *p_instance, void *p_binding) {
+  GodotDartBindings *bindings = GodotDartBindings::instance();
+  if (bindings) {
+    bindings->execute_on_dart_thread([&]() { dart_handle_table::free_handle(p_binding); });
   }
+}
 
-  Dart_ExitScope();
-  return ret;
+GDE_EXPORT GDExtensionBool godot_dart_binding_reference_callback(void *p_token, void *p_binding,
+                                                                 GDExtensionBool p_reference) {
+  return __binding_reference_callback(p_token, p_binding, p_reference);
+}
 }
 
-extern "C" {
+struct FfiNativeEntry {
+  const char *name;
+  uintptr_t argument_count;
+};
 
-GDE_EXPORT void variant_copy(void *dest, void *src, int size) {
-  memcpy(dest, src, size);
+// Functions bound to `@FfiNative` declarations, kFfiNativeFunctions is in the same order
+static constexpr FfiNativeEntry kFfiNatives[] = {
+    {"variant_copy", 3},
+    {"godot_dart_copy_interned_string_name", 3},
+    {"godot_dart_intern_string_names", 4},
+    {"godot_dart_new_instance_handle", 1},
+    {"godot_dart_get_instance_handle", 1},
+    {"godot_dart_gd_string_to_string", 1},
+    {"godot_dart_string_to_gd_string", 2},
+    {"godot_dart_gd_object_to_dart_object", 2},
+    {"godot_dart_ref_to_dart_object", 2},
+    {"godot_dart_post_initialize", 3},
+};
+
+static void *const kFfiNativeFunctions[] = {
+    reinterpret_cast<void *>(variant_copy),
+    reinterpret_cast<void *>(godot_dart_copy_interned_string_name),
+    reinterpret_cast<void *>(godot_dart_intern_string_names),
+    reinterpret_cast<void *>(godot_dart_new_instance_handle),
+    reinterpret_cast<void *>(godot_dart_get_instance_handle),
+    reinterpret_cast<void *>(godot_dart_gd_string_to_string),
+    reinterpret_cast<void *>(godot_dart_string_to_gd_string),
+    reinterpret_cast<void *>(godot_dart_gd_object_to_dart_object),
+    reinterpret_cast<void *>(godot_dart_ref_to_dart_object),
+    reinterpret_cast<void *>(godot_dart_post_initialize),
+};
+static_assert(std::size(kFfiNatives) == std::size(kFfiNativeFunctions));
+
+static constexpr NativeNameTable<FfiNativeEntry, std::size(kFfiNatives), 5> kFfiNativeTable(kFfiNatives);
+static_assert(kFfiNativeTable.is_perfect(), "No perfect hash seed found for kFfiNatives");
+
+void *ffi_native_resolver(const char *name, uintptr_t args_n) {
+  int index = kFfiNativeTable.find_index(name);
+  if (index < 0 || kFfiNatives[index].argument_count != args_n) {
+    return nullptr;
+  }
+
+  return kFfiNativeFunctions[index];
 }
-}
\ No newline at end of file
@@ -1,8 +1,11 @@
 #pragma once
 
+#include <atomic>
+#include <chrono>
 #include <functional>
 #include <mutex>
 #include <semaphore>
+#include <string>
 #include <thread>
 #include <vector>
 
@@ -27,9 +30,27 @@ public:
   explicit GodotDartBindings() : _stopRequested(false), _dart_thread(nullptr), _work_semaphore(0), _done_semaphore(0), _isolate(nullptr) {
   }
 
-  bool initialize(const char *script_path, const char *package_config);
+  // Load the AppJIT `snapshot_path` or precompiled `kernel_path`, if they're supplied, falling
+  // back to `script_path` if neither loads. Neither is loaded unless built with
+  // GODOT_DART_SNAPSHOT_LOADING.
+  bool initialize(const char *script_path, const char *package_config, const char *kernel_path = nullptr,
+                  const char *snapshot_path = nullptr);
   void shutdown();
 
+  // Make this a training run, which writes an AppJIT snapshot of the code compiled while it ran
+  // to `snapshot_path` on shutdown. Must be called before `initialize`.
+  void set_training_snapshot_path(const char *snapshot_path) {
+    _training_snapshot_path = snapshot_path;
+  }
+
+  // Called by virtuals that run every frame, to report the startup time on the first one. These
+  // can run on more than one thread, so only the first caller reports.
+  void on_frame_callback() {
+    if (!_first_frame_reported.load(std::memory_order_relaxed) && !_first_frame_reported.exchange(true)) {
+      report_first_frame();
+    }
+  }
+
   void bind_method(const TypeInfo &bind_type, const char *method_name, const TypeInfo &ret_type_info,
                    const std::vector<TypeInfo> &arg_list);
   void execute_on_dart_thread(std::function<void()> work);
@@ -48,6 +69,8 @@ private:
                        const GDExtensionConstVariantPtr *args, GDExtensionVariantPtr r_return);
 
   void thread_main();
+  void report_first_frame();
+  void write_training_snapshot();
 
   static GodotDartBindings *_instance;
 
@@ -60,6 +83,14 @@ private:
   std::binary_semaphore _done_semaphore;
 
   Dart_Isolate _isolate;
+  // What the isolate was loaded from, for the startup report
+  const char *_loaded_from = nullptr;
+  // The kernel the isolate was created from, which has to outlive it
+  std::vector<uint8_t> _kernel_buffer;
+  std::string _training_snapshot_path;
+  std::chrono::steady_clock::time_point _start_time;
+  std::atomic<bool> _first_frame_reported = false;
+
   Dart_PersistentHandle _godot_dart_library;
   Dart_PersistentHandle _core_types_library;
   Dart_PersistentHandle _native_library;
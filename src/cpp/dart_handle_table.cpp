@@ -0,0 +1,332 @@
+#include "dart_handle_table.h"
+
+#include <mutex>
+#include <stdint.h>
+#include <vector>
+
+#include "gde_wrapper.h"
+
+#define GDE GDEWrapper::instance()->gde()
+
+namespace dart_handle_table {
+
+static constexpr uint32_t kNoFreeSlot = UINT32_MAX;
+
+// Hashes of the RefCounted methods used to hold and release references, from extension_api.json
+static constexpr GDExtensionInt kInitRefHash = 2240911060;
+static constexpr GDExtensionInt kUnreferenceHash = 2240911060;
+static constexpr GDExtensionInt kGetReferenceCountHash = 3905245786;
+
+struct Entry {
+  // Exactly one of `strong` or `weak` is set while the slot is in use. Both are null once a
+  // collected object has been drained and the slot is only waiting for Godot to free it.
+  Dart_PersistentHandle strong = nullptr;
+  Dart_WeakPersistentHandle weak = nullptr;
+  // The RefCounted owner the table holds a reference on, if any.
+  GDExtensionObjectPtr ref_owner = nullptr;
+  bool owner_checked = false;
+  uint32_t next_free = kNoFreeSlot;
+};
+
+static std::vector<Entry> __entries;
+static uint32_t __free_head = kNoFreeSlot;
+
+// Guards growing `__entries` and changing `ref_owner`, which `reference` reads from any thread.
+// Never held while calling into Godot, which can call `reference` back on the same thread.
+static std::mutex __entries_lock;
+
+// Filled by the weak handle finalizer, which can run on any thread.
+static std::mutex __collected_lock;
+static std::vector<uint32_t> __collected;
+
+// Slots whose owner's reference count changed, filled by `reference` from any thread.
+static std::mutex __referenced_lock;
+static std::vector<uint32_t> __referenced;
+
+static void *__ref_counted_tag = nullptr;
+static GDExtensionMethodBindPtr __init_ref = nullptr;
+static GDExtensionMethodBindPtr __unreference = nullptr;
+static GDExtensionMethodBindPtr __get_reference_count = nullptr;
+
+static void *__encode(uint32_t index) {
+  return reinterpret_cast<void *>(static_cast<uintptr_t>(index) + 1);
+}
+
+static uint32_t __decode(void *handle) {
+  return static_cast<uint32_t>(reinterpret_cast<uintptr_t>(handle) - 1);
+}
+
+static GDExtensionMethodBindPtr __get_ref_counted_method(GDExtensionConstStringNamePtr class_name, const char *name,
+                                                          GDExtensionInt hash) {
+  GDExtensionConstStringNamePtr method_name = GDEWrapper::instance()->gd_string_name_intern(name);
+  GDExtensionMethodBindPtr method_bind = GDE->classdb_get_method_bind(class_name, method_name, hash);
+  if (method_bind == nullptr) {
+    GD_PRINT_ERROR("GodotDart: Initialization Error (cannot retrieve RefCounted method bind)");
+    GD_PRINT_ERROR(name);
+  }
+
+  return method_bind;
+}
+
+void initialize() {
+  GDExtensionConstStringNamePtr class_name = GDEWrapper::instance()->gd_string_name_intern("RefCounted");
+  __ref_counted_tag = GDE->classdb_get_class_tag(class_name);
+  __init_ref = __get_ref_counted_method(class_name, "init_ref", kInitRefHash);
+  __unreference = __get_ref_counted_method(class_name, "unreference", kUnreferenceHash);
+  __get_reference_count = __get_ref_counted_method(class_name, "get_reference_count", kGetReferenceCountHash);
+}
+
+void shutdown() {
+  for (Entry &entry : __entries) {
+    if (entry.strong != nullptr) {
+      Dart_DeletePersistentHandle(entry.strong);
+    }
+    if (entry.weak != nullptr) {
+      Dart_DeleteWeakPersistentHandle(entry.weak);
+    }
+  }
+  {
+    std::lock_guard<std::mutex> lock(__entries_lock);
+    __entries.clear();
+    __free_head = kNoFreeSlot;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(__referenced_lock);
+    __referenced.clear();
+  }
+
+  std::lock_guard<std::mutex> lock(__collected_lock);
+  __collected.clear();
+}
+
+static bool __is_ref_counted(GDExtensionObjectPtr owner) {
+  return __ref_counted_tag != nullptr && GDE->object_cast_to(owner, __ref_counted_tag) != nullptr;
+}
+
+static int64_t __get_count(GDExtensionObjectPtr owner) {
+  int64_t count = 0;
+  GDE->object_method_bind_ptrcall(__get_reference_count, owner, nullptr, &count);
+  return count;
+}
+
+static void __weak_handle_finalizer(void *isolate_callback_data, void *peer) {
+  // Only the Dart_Delete* functions can be used here, so defer the rest to `drain_collected`
+  std::lock_guard<std::mutex> lock(__collected_lock);
+  __collected.push_back(__decode(peer));
+}
+
+static void __make_strong(Entry &entry) {
+  Dart_EnterScope();
+  Dart_Handle object = Dart_HandleFromWeakPersistent(entry.weak);
+  // If the object has already been collected leave it for `drain_collected`
+  if (!Dart_IsNull(object)) {
+    entry.strong = Dart_NewPersistentHandle(object);
+    Dart_DeleteWeakPersistentHandle(entry.weak);
+    entry.weak = nullptr;
+  }
+  Dart_ExitScope();
+}
+
+static void __make_weak(Entry &entry, void *handle) {
+  Dart_EnterScope();
+  Dart_Handle object = Dart_HandleFromPersistent(entry.strong);
+  entry.weak = Dart_NewWeakPersistentHandle(object, handle, 0, __weak_handle_finalizer);
+  Dart_DeletePersistentHandle(entry.strong);
+  entry.strong = nullptr;
+  Dart_ExitScope();
+}
+
+void *new_handle(Dart_Handle object) {
+  Dart_PersistentHandle strong = Dart_NewPersistentHandle(object);
+
+  std::lock_guard<std::mutex> lock(__entries_lock);
+  uint32_t index = __free_head;
+  if (index == kNoFreeSlot) {
+    index = static_cast<uint32_t>(__entries.size());
+    __entries.emplace_back();
+  } else {
+    __free_head = __entries[index].next_free;
+  }
+
+  Entry &entry = __entries[index];
+  entry.strong = strong;
+  entry.weak = nullptr;
+  entry.ref_owner = nullptr;
+  entry.owner_checked = false;
+  entry.next_free = kNoFreeSlot;
+
+  return __encode(index);
+}
+
+Dart_Handle get(void *handle) {
+  if (handle == nullptr) {
+    return Dart_Null();
+  }
+
+  const Entry &entry = __entries[__decode(handle)];
+  if (entry.strong != nullptr) {
+    return Dart_HandleFromPersistent(entry.strong);
+  } else if (entry.weak != nullptr) {
+    return Dart_HandleFromWeakPersistent(entry.weak);
+  }
+
+  return Dart_Null();
+}
+
+void free_handle(void *handle) {
+  if (handle == nullptr) {
+    return;
+  }
+
+  uint32_t index = __decode(handle);
+  Entry &entry = __entries[index];
+  if (entry.strong != nullptr) {
+    Dart_DeletePersistentHandle(entry.strong);
+  }
+  if (entry.weak != nullptr) {
+    Dart_DeleteWeakPersistentHandle(entry.weak);
+  }
+
+  // Godot is destroying the owner, so there is no reference left to release
+  std::lock_guard<std::mutex> lock(__entries_lock);
+  entry = Entry();
+  entry.next_free = __free_head;
+  __free_head = index;
+}
+
+void hold_reference(void *handle, GDExtensionObjectPtr owner) {
+  Entry &entry = __entries[__decode(handle)];
+  if (entry.owner_checked || owner == nullptr) {
+    return;
+  }
+
+  entry.owner_checked = true;
+  if (__init_ref == nullptr || !__is_ref_counted(owner)) {
+    return;
+  }
+
+  // Set the owner first so the reference callback from `init_ref` sees the held reference
+  {
+    std::lock_guard<std::mutex> lock(__entries_lock);
+    entry.ref_owner = owner;
+  }
+  GDExtensionBool ret = false;
+  GDE->object_method_bind_ptrcall(__init_ref, owner, nullptr, &ret);
+}
+
+bool detach(void *handle) {
+  Entry &entry = __entries[__decode(handle)];
+  {
+    std::lock_guard<std::mutex> lock(__entries_lock);
+    entry.ref_owner = nullptr;
+  }
+  entry.owner_checked = false;
+  if (entry.weak != nullptr) {
+    __make_strong(entry);
+  }
+
+  return entry.strong != nullptr;
+}
+
+void release_extra_reference(void *handle) {
+  GDExtensionObjectPtr owner = __entries[__decode(handle)].ref_owner;
+  if (owner == nullptr) {
+    return;
+  }
+
+  GDExtensionBool should_die = false;
+  GDE->object_method_bind_ptrcall(__unreference, owner, nullptr, &should_die);
+}
+
+GDExtensionBool reference(void *handle, GDExtensionBool p_reference) {
+  if (handle == nullptr) {
+    return true;
+  }
+
+  uint32_t index = __decode(handle);
+  {
+    std::lock_guard<std::mutex> lock(__entries_lock);
+    // Without a reference of the table's own the owner can die as far as Dart is concerned,
+    // otherwise the table's reference keeps it alive until it's released in `drain_collected`.
+    if (index >= __entries.size() || __entries[index].ref_owner == nullptr) {
+      return true;
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(__referenced_lock);
+  __referenced.push_back(index);
+  return false;
+}
+
+void update_reference(void *handle) {
+  Entry &entry = __entries[__decode(handle)];
+  if (entry.ref_owner == nullptr) {
+    return;
+  }
+
+  // The table's own reference is one of the count, so the Dart object only needs to be held
+  // strongly while anything else references the owner. An object that was collected before it
+  // could be made strong is left for `drain_collected`.
+  int64_t count = __get_count(entry.ref_owner);
+  if (count > 1 && entry.weak != nullptr) {
+    __make_strong(entry);
+  } else if (count == 1 && entry.strong != nullptr) {
+    __make_weak(entry, handle);
+  }
+}
+
+void drain_collected() {
+  std::vector<uint32_t> referenced;
+  {
+    std::lock_guard<std::mutex> lock(__referenced_lock);
+    referenced.swap(__referenced);
+  }
+  // Updating only looks at the current count, so slots recorded more than once are harmless
+  for (uint32_t index : referenced) {
+    if (index < __entries.size()) {
+      update_reference(__encode(index));
+    }
+  }
+
+  std::vector<uint32_t> collected;
+  {
+    std::lock_guard<std::mutex> lock(__collected_lock);
+    if (__collected.empty()) {
+      return;
+    }
+    collected.swap(__collected);
+  }
+
+  for (uint32_t index : collected) {
+    if (index >= __entries.size() || __entries[index].weak == nullptr) {
+      continue;
+    }
+
+    Dart_EnterScope();
+    bool is_collected = Dart_IsNull(Dart_HandleFromWeakPersistent(__entries[index].weak));
+    Dart_ExitScope();
+    if (!is_collected) {
+      continue;
+    }
+
+    Dart_DeleteWeakPersistentHandle(__entries[index].weak);
+    __entries[index].weak = nullptr;
+
+    // Destroying the owner calls back into `free_handle` for this slot
+    GDExtensionObjectPtr owner = __entries[index].ref_owner;
+    {
+      std::lock_guard<std::mutex> lock(__entries_lock);
+      __entries[index].ref_owner = nullptr;
+    }
+    if (owner != nullptr) {
+      GDExtensionBool should_die = false;
+      GDE->object_method_bind_ptrcall(__unreference, owner, nullptr, &should_die);
+      if (should_die) {
+        GDE->object_destroy(owner);
+      }
+    }
+  }
+}
+
+} // namespace dart_handle_table
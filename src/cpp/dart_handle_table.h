@@ -0,0 +1,52 @@
+#pragma once
+
+#include <dart_api.h>
+#include <godot/gdextension_interface.h>
+
+// Table of the Dart objects bound to Godot objects. Godot is handed an index into the table
+// (encoded as a pointer) as both the instance pointer and the instance binding, instead of a
+// persistent handle per object.
+//
+// Objects are held strongly while Godot holds them. RefCounted objects are held through a
+// Godot reference that the table owns, and when that is the last reference left the Dart
+// object is only held weakly. If Dart then collects the object the table's reference is
+// released the next time the table is drained on the Dart thread.
+//
+// Godot reports reference changes from any thread and from inside leaf FFI calls, where the
+// Dart API can't be used, so `reference` only records them. Switching between strong and weak
+// handles happens when the table is drained.
+namespace dart_handle_table {
+
+void initialize();
+void shutdown();
+
+void *new_handle(Dart_Handle object);
+// Returns the object bound to `handle`, or Dart_Null if it has been collected.
+Dart_Handle get(void *handle);
+// Release the slot of an object Godot has destroyed.
+void free_handle(void *handle);
+
+// Take a reference on `owner` if it is RefCounted and the handle does not hold one yet. This
+// must be called after the handle is set as the owner's instance binding, and not from inside
+// a binding create callback where Godot holds the (non-recursive) binding lock.
+void hold_reference(void *handle, GDExtensionObjectPtr owner);
+// Detach a destroyed owner from the handle without releasing the slot. Returns false if the
+// object has already been collected, in which case the slot should be freed instead.
+bool detach(void *handle);
+// Release a reference on the handle's owner that the caller was given along with the object, such
+// as a Ref returned from a ptrcall. Does nothing unless the table holds its own reference, so this
+// never releases the last one.
+void release_extra_reference(void *handle);
+
+// The instance binding reference callback. Doesn't use the Dart API and can be called from any
+// thread.
+GDExtensionBool reference(void *handle, GDExtensionBool p_reference);
+// Hold the handle's object strongly or weakly to match its owner's current reference count,
+// without waiting for the next drain. Must be called on the Dart thread.
+void update_reference(void *handle);
+
+// Apply the reference changes recorded by `reference` and release the references of objects
+// collected by Dart. Must be called on the Dart thread, outside of any leaf call.
+void drain_collected();
+
+} // namespace dart_handle_table
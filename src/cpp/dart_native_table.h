@@ -0,0 +1,79 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "gde_wrapper.h"
+
+// A perfect hash table over a fixed list of native names, built at compile time. `Entry` needs a
+// `const char *name` member. A lookup hashes the name once, reads a single slot and confirms the
+// match with one strcmp, no matter how many natives are registered.
+template <typename Entry, size_t kCount, size_t kBits> class NativeNameTable {
+public:
+  constexpr NativeNameTable(const Entry (&entries)[kCount]) : _entries{}, _slots{}, _seed(kNoSeed) {
+    for (size_t i = 0; i < kCount; ++i) {
+      _entries[i] = entries[i];
+    }
+
+    _seed = find_seed();
+    for (size_t i = 0; i < kSize; ++i) {
+      _slots[i] = -1;
+    }
+    if (_seed != kNoSeed) {
+      for (size_t i = 0; i < kCount; ++i) {
+        _slots[slot(gd_string_name_hash(_entries[i].name), _seed)] = static_cast<int16_t>(i);
+      }
+    }
+  }
+
+  constexpr bool is_perfect() const {
+    return _seed != kNoSeed;
+  }
+
+  // Returns the index of `name` in the list the table was built from, or -1.
+  int find_index(const char *name) const {
+    int16_t index = _slots[slot(gd_string_name_hash(name), _seed)];
+    if (index < 0 || strcmp(_entries[index].name, name) != 0) {
+      return -1;
+    }
+
+    return index;
+  }
+
+  const Entry *find(const char *name) const {
+    int index = find_index(name);
+    return index < 0 ? nullptr : &_entries[index];
+  }
+
+private:
+  static constexpr size_t kSize = size_t(1) << kBits;
+  static constexpr uint64_t kNoSeed = UINT64_MAX;
+  // Keeping the table at most half full means a seed is found within a few tries
+  static_assert(kCount * 2 <= kSize, "NativeNameTable is too small for its entries");
+
+  static constexpr size_t slot(uint64_t hash, uint64_t seed) {
+    return static_cast<size_t>(((hash ^ seed) * 0x9E3779B97F4A7C15ull) >> (64 - kBits));
+  }
+
+  constexpr uint64_t find_seed() const {
+    for (uint64_t seed = 0; seed < 4096; ++seed) {
+      bool used[kSize] = {};
+      bool collision = false;
+      for (size_t i = 0; i < kCount && !collision; ++i) {
+        size_t s = slot(gd_string_name_hash(_entries[i].name), seed);
+        collision = used[s];
+        used[s] = true;
+      }
+      if (!collision) {
+        return seed;
+      }
+    }
+
+    return kNoSeed;
+  }
+
+  Entry _entries[kCount];
+  int16_t _slots[kSize];
+  uint64_t _seed;
+};
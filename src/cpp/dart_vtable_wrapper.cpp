@@ -28,6 +28,7 @@ uint32_t next_available_thunk = 0;
 
 GDExtensionClassCallVirtual virtual_thunks[MAX_VIRTUAL] = {0};
 GDExtensionClassCallVirtual dart_virtual_func[MAX_VIRTUAL] = {0};
+bool is_frame_callback[MAX_VIRTUAL] = {0};
 
 template <int i> void _init_virtual_thunks() {
   virtual_thunks[i] = &virtual_thunk<i>;
@@ -51,6 +52,10 @@ void virtual_thunk(GDExtensionClassInstancePtr p_instance, const GDExtensionCons
     return;
   }
 
+  if (is_frame_callback[i]) {
+    bindings->on_frame_callback();
+  }
+
   bindings->execute_on_dart_thread([&]() { dart_call(p_instance, p_args, r_ret); });
 }
 
@@ -58,7 +63,8 @@ void init_virtual_thunks() {
   _init_virtual_thunks<MAX_VIRTUAL - 1>();
 }
 
-GDExtensionClassCallVirtual get_wrapped_virtual(GDExtensionClassCallVirtual unwrapped_virtual) {
+GDExtensionClassCallVirtual get_wrapped_virtual(GDExtensionClassCallVirtual unwrapped_virtual,
+                                                bool frame_callback) {
   const auto &indexItr = thunk_map.find(reinterpret_cast<intptr_t>(unwrapped_virtual));
   if (indexItr != thunk_map.end()) {
     uint32_t index = indexItr->second;
@@ -71,6 +77,7 @@ GDExtensionClassCallVirtual get_wrapped_virtual(GDExtensionClassCallVirtual unwr
 
   GDExtensionClassCallVirtual thunk = virtual_thunks[next_available_thunk];
   dart_virtual_func[next_available_thunk] = unwrapped_virtual;
+  is_frame_callback[next_available_thunk] = frame_callback;
   thunk_map[reinterpret_cast<intptr_t>(unwrapped_virtual)] = next_available_thunk;
 
   next_available_thunk++;
@@ -5,6 +5,9 @@
 namespace dart_vtable_wrapper {
 
 void init_virtual_thunks();
-GDExtensionClassCallVirtual get_wrapped_virtual(GDExtensionClassCallVirtual unwrapped_virtual);
+// `is_frame_callback` marks virtuals Godot calls every frame (_process), which report the
+// startup time on their first call
+GDExtensionClassCallVirtual get_wrapped_virtual(GDExtensionClassCallVirtual unwrapped_virtual,
+                                                bool is_frame_callback = false);
 
 } // namespace dart_vtable_wrapper
\ No newline at end of file
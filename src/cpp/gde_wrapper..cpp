@@ -37,6 +37,12 @@ bool GDEWrapper::initialize() {
                    "constructor)");
     return false;
   }
+  _gdstringname_copy_constructor = _gde_interface->variant_get_ptr_constructor(GDEXTENSION_VARIANT_TYPE_STRING_NAME, 1);
+  if (_gdstringname_copy_constructor == nullptr) {
+    GD_PRINT_ERROR("GodotDart: Initialization Error (cannot retrive `StringName(StringName &)` "
+                   "constructor)");
+    return false;
+  }
   _gdstringname_destructor = _gde_interface->variant_get_ptr_destructor(GDEXTENSION_VARIANT_TYPE_STRING_NAME);
   if (_gdstringname_destructor == nullptr) {
     GD_PRINT_ERROR("GodotDart: Initialization Error (cannot retrive `StringName` "
@@ -66,6 +72,70 @@ void GDEWrapper::gd_string_name_destructor(GDExtensionStringNamePtr ptr) {
   _gdstringname_destructor(ptr);
 }
 
+GDExtensionConstStringNamePtr GDEWrapper::gd_string_name_intern(uint64_t hash, const char *cstr) {
+  std::lock_guard<std::mutex> lock(_interned_lock);
+
+  auto itr = _interned_string_names.find(hash);
+  if (itr != _interned_string_names.end()) {
+    if (itr->second->name != cstr) {
+      GD_PRINT_ERROR("GodotDart: StringName hash collision interning name:");
+      GD_PRINT_ERROR(cstr);
+      return nullptr;
+    }
+    return itr->second->string_name;
+  }
+
+  std::unique_ptr<InternedStringName> interned(new InternedStringName());
+  interned->name = cstr;
+  gd_string_name_new(interned->string_name, cstr);
+
+  GDExtensionConstStringNamePtr result = interned->string_name;
+  _interned_string_names.emplace(hash, std::move(interned));
+  return result;
+}
+
+GDExtensionConstStringNamePtr GDEWrapper::gd_string_name_keep(uint64_t hash, const char *cstr) {
+  GDExtensionConstStringNamePtr interned = gd_string_name_intern(hash, cstr);
+  if (interned != nullptr) {
+    return interned;
+  }
+
+  std::lock_guard<std::mutex> lock(_interned_lock);
+  std::unique_ptr<InternedStringName> kept(new InternedStringName());
+  kept->name = cstr;
+  gd_string_name_new(kept->string_name, cstr);
+
+  GDExtensionConstStringNamePtr result = kept->string_name;
+  _kept_string_names.push_back(std::move(kept));
+  return result;
+}
+
+GDExtensionConstStringNamePtr GDEWrapper::gd_string_name_lookup(uint64_t hash) {
+  std::lock_guard<std::mutex> lock(_interned_lock);
+
+  auto itr = _interned_string_names.find(hash);
+  return itr == _interned_string_names.end() ? nullptr : itr->second->string_name;
+}
+
+void GDEWrapper::gd_string_name_copy(GDExtensionStringNamePtr out, GDExtensionConstStringNamePtr src) {
+  const GDExtensionConstTypePtr args[1] = {src};
+  _gdstringname_copy_constructor(out, args);
+}
+
+void GDEWrapper::clear_interned_string_names() {
+  std::lock_guard<std::mutex> lock(_interned_lock);
+
+  for (auto &itr : _interned_string_names) {
+    _gdstringname_destructor(itr.second->string_name);
+  }
+  _interned_string_names.clear();
+
+  for (auto &kept : _kept_string_names) {
+    _gdstringname_destructor(kept->string_name);
+  }
+  _kept_string_names.clear();
+}
+
 void GDEWrapper::gd_string_new(GDExtensionTypePtr out) {
   _gdstring_constructor(out, nullptr);
 }
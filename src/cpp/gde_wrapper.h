@@ -1,5 +1,12 @@
 #pragma once
 
+#include <memory>
+#include <mutex>
+#include <stdint.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 #include <godot/gdextension_interface.h>
 
 #if !defined(GDE_EXPORT)
@@ -21,6 +28,17 @@
 #define GD_PRINT_WARNING(msg)                                                                                          \
   { GDEWrapper::instance()->gde()->print_warning(msg, __func__, __FILE__, __LINE__, true); }
 
+// 64-bit FNV-1a hash of a C string, the key for interned StringNames. It's constexpr so literal
+// names can be hashed at compile time, and the binding generator emits the same hash for Dart.
+constexpr uint64_t gd_string_name_hash(const char *cstr) {
+  uint64_t hash = 14695981039346656037ull;
+  for (; *cstr != '\0'; ++cstr) {
+    hash ^= static_cast<uint8_t>(*cstr);
+    hash *= 1099511628211ull;
+  }
+  return hash;
+}
+
 class GDEWrapper {
 public:
   static void create_instance(const GDExtensionInterface *gde_interface, GDExtensionClassLibraryPtr library);
@@ -40,6 +58,20 @@ public:
   void gd_string_name_new(GDExtensionStringNamePtr out, const char *cstr);
   void gd_string_name_destructor(GDExtensionStringNamePtr ptr);
 
+  // Interned StringNames are shared by the whole process and live until `clear_interned_string_names`.
+  // Callers must not destruct them. Returns nullptr if `hash` is already used by a different name.
+  GDExtensionConstStringNamePtr gd_string_name_intern(const char *cstr) {
+    return gd_string_name_intern(gd_string_name_hash(cstr), cstr);
+  }
+  GDExtensionConstStringNamePtr gd_string_name_intern(uint64_t hash, const char *cstr);
+  // Returns nullptr if nothing has been interned with `hash`
+  GDExtensionConstStringNamePtr gd_string_name_lookup(uint64_t hash);
+  // Like `gd_string_name_intern`, but a name whose hash is already used gets a StringName of its
+  // own instead of nullptr, which also lives until `clear_interned_string_names`
+  GDExtensionConstStringNamePtr gd_string_name_keep(uint64_t hash, const char *cstr);
+  void gd_string_name_copy(GDExtensionStringNamePtr out, GDExtensionConstStringNamePtr src);
+  void clear_interned_string_names();
+
   void gd_string_new(GDExtensionTypePtr out);
   void gd_string_from_string_name(GDExtensionConstStringNamePtr ptr, uint8_t* out);
   void gd_string_destructor(GDExtensionTypePtr ptr);
@@ -57,5 +89,21 @@ private:
   GDExtensionPtrConstructor _gdstring_from_gdstringname_constructor = nullptr;
   GDExtensionPtrDestructor _gdstring_destructor = nullptr;
   GDExtensionPtrConstructor _gdstringname_from_gdstring_constructor = nullptr;
+  GDExtensionPtrConstructor _gdstringname_copy_constructor = nullptr;
   GDExtensionPtrDestructor _gdstringname_destructor = nullptr;
+
+  struct InternedStringName {
+    std::string name;
+    uint8_t string_name[GD_STRING_NAME_MAX_SIZE];
+  };
+  // Keys are already hashes
+  struct InternHash {
+    size_t operator()(uint64_t hash) const {
+      return static_cast<size_t>(hash);
+    }
+  };
+  std::mutex _interned_lock;
+  std::unordered_map<uint64_t, std::unique_ptr<InternedStringName>, InternHash> _interned_string_names;
+  // Names kept by `gd_string_name_keep` that collided with an interned one
+  std::vector<std::unique_ptr<InternedStringName>> _kept_string_names;
 };
\ No newline at end of file
@@ -1,3 +1,9 @@
+#include <filesystem>
+#include <fstream>
+#include <stdlib.h>
+#include <string>
+
+#include <dart_api.h>
 #include <godot/gdextension_interface.h>
 
 #include "dart_bindings.h"
@@ -11,6 +17,146 @@ const uint32_t kGetBaseDirHash = 3942272618;
 
 GodotDartBindings *dart_bindings = nullptr;
 
+// Paths from Godot and the deps file are UTF-8
+static std::filesystem::path utf8_path(const char *path) {
+  return std::filesystem::path(reinterpret_cast<const char8_t *>(path));
+}
+
+// Whether any Dart source under `dir` was modified after `time`. Hidden
+// directories, such as `.dart_tool`, are skipped.
+static bool sources_newer_than(const std::filesystem::path &dir, std::filesystem::file_time_type time) {
+  std::error_code ec;
+  std::filesystem::recursive_directory_iterator it(dir, ec), end;
+  for (; !ec && it != end; it.increment(ec)) {
+    const std::filesystem::path &path = it->path();
+    if (it->is_directory(ec)) {
+      if (path.filename().string().starts_with(".")) {
+        it.disable_recursion_pending();
+      }
+    } else if (path.extension() == ".dart" && it->last_write_time(ec) > time) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Whether `built_path`, a kernel or snapshot, was built after the last change to the sources.
+// These are the script's directory and whatever is listed in the `.deps` file written next to
+// the kernel by `dart run godot_dart:compile_kernel`, one directory or file per line.
+static bool is_build_current(const std::filesystem::path &built_path, const std::filesystem::path &kernel_path,
+                             const std::filesystem::path &script_dir) {
+  std::error_code ec;
+  auto built_time = std::filesystem::last_write_time(built_path, ec);
+  if (ec) {
+    return false;
+  }
+
+  if (sources_newer_than(script_dir, built_time)) {
+    return false;
+  }
+
+  std::filesystem::path deps_path = kernel_path;
+  deps_path += ".deps";
+  std::ifstream deps(deps_path);
+  std::string line;
+  while (std::getline(deps, line)) {
+    if (line.empty()) {
+      continue;
+    }
+    std::filesystem::path dep = utf8_path(line.c_str());
+    if (std::filesystem::is_directory(dep, ec)) {
+      if (sources_newer_than(dep, built_time)) {
+        return false;
+      }
+    } else {
+      // A missing file counts as changed
+      auto dep_time = std::filesystem::last_write_time(dep, ec);
+      if (ec || dep_time > built_time) {
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+#ifdef GODOT_DART_PRECOMPILED_RUNTIME
+// Start a precompiled runtime build of dart_dll from the ELF snapshot made by
+// `dart compile aot-snapshot src/main.dart -o main.aot`, which sits next to the library in exported
+// games. The precompiled runtime has no kernel service or JIT, so there's nothing to fall back to.
+static bool initialize_aot(const char *basedir_path) {
+  if (!Dart_IsPrecompiledRuntime()) {
+    GD_PRINT_ERROR("GodotDart: Initialization Error (built with GODOT_DART_PRECOMPILED_RUNTIME, but "
+                   "dart_dll is a JIT build)");
+    return false;
+  }
+
+  char aot_path[256];
+  sprintf_s(aot_path, "%s/main.aot", basedir_path);
+  if (!std::filesystem::exists(utf8_path(aot_path))) {
+    GD_PRINT_ERROR("GodotDart: Initialization Error (`main.aot` not found next to the library, which is "
+                   "required with a precompiled runtime)");
+    return false;
+  }
+
+  return dart_bindings->initialize(aot_path, nullptr);
+}
+#endif
+
+// Start a JIT build of dart_dll from the newest of the AppJIT snapshot, kernel and sources in `src`
+static bool initialize_jit(const char *basedir_path) {
+  char dart_script_dir[256], dart_script_path[256], kernel_path[256], snapshot_path[256], package_path[256];
+  sprintf_s(dart_script_dir, "%s/src", basedir_path);
+  sprintf_s(dart_script_path, "%s/src/main.dart", basedir_path);
+  sprintf_s(kernel_path, "%s/src/main.dill", basedir_path);
+  sprintf_s(snapshot_path, "%s/src/main.jit", basedir_path);
+  sprintf_s(package_path, "%s/src/.dart_tool/package_config.json", basedir_path);
+
+  // Prefer the precompiled kernel, which skips compiling the sources on every launch, unless
+  // the sources changed since it was built
+  std::filesystem::path deps_path = utf8_path(kernel_path);
+  deps_path += ".deps";
+#ifdef GODOT_DART_SNAPSHOT_LOADING
+  bool use_kernel =
+      is_build_current(utf8_path(kernel_path), utf8_path(kernel_path), utf8_path(dart_script_dir));
+  if (!use_kernel && std::filesystem::exists(utf8_path(kernel_path))) {
+    GD_PRINT_WARNING("GodotDart: `src/main.dill` is out of date, loading from source. Run `dart run "
+                     "godot_dart:compile_kernel` in `src` to rebuild it.");
+  } else if (!use_kernel && std::filesystem::exists(deps_path)) {
+    // The deps are written after the kernel, so the kernel was deleted or never finished
+    GD_PRINT_WARNING("GodotDart: `src/main.dill` is missing, loading from source. Run `dart run "
+                     "godot_dart:compile_kernel` in `src` to rebuild it.");
+  }
+#else
+  bool use_kernel = false;
+  if (std::filesystem::exists(utf8_path(kernel_path)) || std::filesystem::exists(deps_path)) {
+    GD_PRINT_WARNING("GodotDart: This build can't load `src/main.dill`, loading from source. Build with "
+                     "GODOT_DART_SNAPSHOT_LOADING against a dart_dll that exports `DartDll_LoadKernel`.");
+  }
+#endif
+
+  // A training run (GODOT_DART_TRAINING set in the environment) starts without the AppJIT
+  // snapshot and writes a new one on exit. Other runs start from the snapshot while it's current.
+  bool training = getenv("GODOT_DART_TRAINING") != nullptr;
+#ifdef GODOT_DART_SNAPSHOT_LOADING
+  bool use_snapshot =
+      !training && is_build_current(utf8_path(snapshot_path), utf8_path(kernel_path), utf8_path(dart_script_dir));
+
+  if (training) {
+    dart_bindings->set_training_snapshot_path(snapshot_path);
+  }
+#else
+  bool use_snapshot = false;
+  if (training || std::filesystem::exists(utf8_path(snapshot_path))) {
+    GD_PRINT_WARNING("GodotDart: This build can't load AppJIT snapshots, ignoring `src/main.jit` and "
+                     "GODOT_DART_TRAINING. Build with GODOT_DART_SNAPSHOT_LOADING against a dart_dll that "
+                     "exports `DartDll_LoadAppJitSnapshot`.");
+  }
+#endif
+  return dart_bindings->initialize(dart_script_path, package_path, use_kernel ? kernel_path : nullptr,
+                                   use_snapshot ? snapshot_path : nullptr);
+}
+
 void initialize_level(void *userdata, GDExtensionInitializationLevel p_level) {
   // TODO - Should we setup different types at different times?
   if (p_level != GDEXTENSION_INITIALIZATION_SCENE) {
@@ -23,11 +169,8 @@ void initialize_level(void *userdata, GDExtensionInitializationLevel p_level) {
     return;
   }
 
-  uint8_t gdsn_method_name[GD_STRING_NAME_MAX_SIZE];
-  gde->gd_string_name_new(&gdsn_method_name, "get_base_dir");
-  GDExtensionPtrBuiltInMethod get_base_dir =
-      gde->gde()->variant_get_ptr_builtin_method(GDEXTENSION_VARIANT_TYPE_STRING, gdsn_method_name, kGetBaseDirHash);
-  gde->gd_string_name_destructor(gdsn_method_name);
+  GDExtensionPtrBuiltInMethod get_base_dir = gde->gde()->variant_get_ptr_builtin_method(
+      GDEXTENSION_VARIANT_TYPE_STRING, gde->gd_string_name_intern("get_base_dir"), kGetBaseDirHash);
   if (get_base_dir == nullptr) {
     GD_PRINT_ERROR("GodotDart: Initialization Error (cannot retrieve "
                    "`String.get_base_dir` method)");
@@ -57,12 +200,13 @@ void initialize_level(void *userdata, GDExtensionInitializationLevel p_level) {
   basedir_path[basedir_path_size] = '\0';
   gde->gd_string_destructor(gd_basedir_path);
 
-  char dart_script_path[256], package_path[256];
-  sprintf_s(dart_script_path, "%s/src/main.dart", basedir_path);
-  sprintf_s(package_path, "%s/src/.dart_tool/package_config.json", basedir_path);
-
   dart_bindings = new GodotDartBindings();
-  if (!dart_bindings->initialize(dart_script_path, package_path)) {
+#ifdef GODOT_DART_PRECOMPILED_RUNTIME
+  bool initialized = initialize_aot(basedir_path);
+#else
+  bool initialized = initialize_jit(basedir_path);
+#endif
+  if (!initialized) {
     delete dart_bindings;
     dart_bindings = nullptr;
   }
@@ -78,6 +222,8 @@ void deinitialize_level(void *userdata, GDExtensionInitializationLevel p_level)
     delete dart_bindings;
     dart_bindings = nullptr;
   }
+
+  GDEWrapper::instance()->clear_interned_string_names();
 }
 
 } // namespace godot_dart
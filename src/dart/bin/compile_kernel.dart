@@ -0,0 +1,75 @@
+import 'dart:convert';
+import 'dart:io';
+
+import 'package:path/path.dart' as path;
+
+// Precompiles a Godot project's Dart code to a kernel file, which the
+// extension loads instead of compiling `main.dart` on every launch.
+//
+// Run from the project's `src` directory, after `dart pub get`:
+//
+//   dart run godot_dart:compile_kernel
+//
+// This writes `main.dill` and `main.dill.deps`, which lists what the kernel
+// was built from beyond the `src` directory itself: the package config and
+// the roots of path dependencies, such as godot_dart. The extension falls back
+// to loading `main.dart` if any of those were modified after the kernel.
+Future<void> main(List<String> arguments) async {
+  final scriptDir = Directory.current.absolute.path;
+  final script = path.join(scriptDir, 'main.dart');
+  final kernel = path.join(scriptDir, 'main.dill');
+  final packageConfig =
+      path.join(scriptDir, '.dart_tool', 'package_config.json');
+
+  if (!File(script).existsSync()) {
+    stderr.writeln('Could not find main.dart, run this from your src '
+        'directory');
+    exitCode = 1;
+    return;
+  }
+  if (!File(packageConfig).existsSync()) {
+    stderr.writeln('Could not find the package config, run `dart pub get`');
+    exitCode = 1;
+    return;
+  }
+
+  final result = await Process.run(Platform.resolvedExecutable, [
+    'compile',
+    'kernel',
+    '--packages=$packageConfig',
+    '-o',
+    kernel,
+    ...arguments,
+    script,
+  ]);
+  stdout.write(result.stdout);
+  stderr.write(result.stderr);
+  if (result.exitCode != 0) {
+    exitCode = result.exitCode;
+    return;
+  }
+
+  final deps = [packageConfig, ..._pathDependencies(packageConfig, scriptDir)];
+  File('$kernel.deps').writeAsStringSync('${deps.join('\n')}\n');
+}
+
+// The root directories of the packages in [packageConfig] that are path
+// dependencies. Pub writes their root as a relative URI, while hosted packages
+// live in the pub cache at an absolute one and only change along with the
+// package config.
+Iterable<String> _pathDependencies(String packageConfig, String scriptDir) {
+  final config = jsonDecode(File(packageConfig).readAsStringSync())
+      as Map<String, dynamic>;
+  final configUri = Uri.file(packageConfig);
+  final roots = <String>[];
+  for (final package in config['packages'] as List<dynamic>) {
+    final rootUri = Uri.parse(package['rootUri'] as String);
+    if (rootUri.hasScheme) continue;
+
+    final root = path.normalize(configUri.resolveUri(rootUri).toFilePath());
+    // The project itself is already checked by the extension
+    if (path.equals(root, scriptDir)) continue;
+    roots.add(root);
+  }
+  return roots;
+}
@@ -10,9 +10,13 @@ import 'src/script/dart_script_language.dart';
 
 export 'src/core/core_types.dart';
 export 'src/core/gdextension.dart';
+export 'src/core/godot_arena.dart';
 export 'src/core/type_info.dart';
 export 'src/gen/classes/engine_classes.dart';
+export 'src/gen/godot_names.dart';
 export 'src/gen/variant/builtins.dart';
+export 'src/variant/collections.dart';
+export 'src/variant/packed_array_views.dart';
 export 'src/variant/variant.dart';
 
 // ignore: unused_element
@@ -28,6 +32,8 @@ void _registerGodot(int gdeAddress, int libraryAddress) {
   // TODO: Assert everything is how we expect..
   _globalExtension = GodotDart(extensionInterface, libraryPtr);
 
+  // Intern the names used by the bindings before anything looks them up
+  GodotNames.init();
   initVariantBindings(extensionInterface.ref);
   TypeInfo.initTypeMappings();
 
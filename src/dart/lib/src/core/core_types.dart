@@ -1,4 +1,5 @@
 import 'dart:ffi';
+import 'dart:nativewrappers';
 
 import 'package:ffi/ffi.dart';
 import 'package:meta/meta.dart';
@@ -7,7 +8,10 @@ import '../../godot_dart.dart';
 import 'gdextension_ffi_bindings.dart';
 
 /// Core interface for types that can convert to Variant (the builtin types)
-abstract class BuiltinType {
+///
+/// The native side caches [nativePtr] in this object's native field so it can
+/// read it without calling back into Dart.
+abstract class BuiltinType extends NativeFieldWrapperClass1 {
   static final Finalizer<Pointer<Uint8>> _finalizer =
       Finalizer((mem) => calloc.free(mem));
 
@@ -15,13 +19,36 @@ abstract class BuiltinType {
   Pointer<Uint8> get nativePtr;
 
   BuiltinType() {
-    _finalizer.attach(this, nativePtr);
+    // Storage from a frame scope is released with the scope
+    if (!GodotArena.owns(nativePtr)) {
+      _finalizer.attach(this, nativePtr);
+    }
   }
+
+  /// For builtins whose [nativePtr] is owned elsewhere and must not be freed
+  /// with the object, or that don't keep native storage at all, like the math
+  /// value types.
+  BuiltinType.unowned();
+}
+
+/// Builtins kept as plain values in Dart, like the math types. They have no
+/// native storage, so they are passed to Godot by writing them to memory the
+/// caller provides with [copyToNative].
+abstract class BuiltinValueType extends BuiltinType {
+  BuiltinValueType.unowned() : super.unowned();
+
+  /// Write this value in Godot's layout to [dest], which must hold at least
+  /// [TypeInfo.size] bytes.
+  void copyToNative(Pointer<Void> dest);
 }
 
 /// Core interface for engine classes
-abstract class ExtensionType {
+///
+/// The native side caches [nativePtr] in this object's native field so it can
+/// read it without calling back into Dart.
+abstract class ExtensionType extends NativeFieldWrapperClass1 {
   late GDExtensionObjectPtr _owner = Pointer.fromAddress(0);
+  @pragma('vm:entry-point')
   GDExtensionObjectPtr get nativePtr => _owner;
 
   ExtensionType.forType(StringName typeName) {
@@ -33,6 +60,19 @@ abstract class ExtensionType {
   TypeInfo get staticTypeInfo;
 
   @protected
-  @pragma('vm:external-name', 'ExtensionType::postInitialize')
-  external void postInitialize();
+  void postInitialize() {
+    gde.dartBindings.postInitialize(this);
+  }
+
+  /// Called when a pooled instance is handed out again for a new Godot object
+  /// (see [TypeInfo.poolSize]). [nativePtr] already points to the new object.
+  /// Override this to reset any state left over from the previous use.
+  @protected
+  void resetForReuse() {}
+}
+
+@pragma('vm:entry-point')
+void _reuseFromPool(ExtensionType object, int ownerAddress) {
+  object._owner = Pointer.fromAddress(ownerAddress);
+  object.resetForReuse();
 }
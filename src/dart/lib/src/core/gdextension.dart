@@ -5,9 +5,20 @@ import 'package:ffi/ffi.dart';
 import '../../godot_dart.dart';
 import 'gdextension_ffi_bindings.dart';
 import 'godot_dart_native_bindings.dart';
+import 'scratch_buffer.dart';
 
 GodotDart get gde => GodotDart.instance!;
 
+/// Whether Variants of [variantType] can hold RefCounted Objects.
+///
+/// Copying or destroying such a value can change an Object's reference count,
+/// which calls the bindings' reference callback and can free instances bound
+/// to Dart. Functions that can do that must not be leaf calls.
+bool variantTypeHoldsObjects(int variantType) =>
+    variantType == GDExtensionVariantType.GDEXTENSION_VARIANT_TYPE_OBJECT ||
+    variantType == GDExtensionVariantType.GDEXTENSION_VARIANT_TYPE_ARRAY ||
+    variantType == GDExtensionVariantType.GDEXTENSION_VARIANT_TYPE_DICTIONARY;
+
 typedef GodotVirtualFunction = NativeFunction<
     Void Function(GDExtensionClassInstancePtr, Pointer<GDExtensionConstTypePtr>,
         GDExtensionTypePtr)>;
@@ -22,6 +33,145 @@ class GodotDart {
 
   late GodotDartNativeBindings dartBindings;
 
+  // Interface functions, resolved once on first use
+  late final _variantGetPtrConstructor = interface
+      .ref.variant_get_ptr_constructor
+      .asFunction<GDExtensionPtrConstructor Function(int, int)>(isLeaf: true);
+  late final _variantGetPtrDestructor = interface.ref.variant_get_ptr_destructor
+      .asFunction<GDExtensionPtrDestructor Function(int)>(isLeaf: true);
+  late final _variantGetPtrGetter = interface.ref.variant_get_ptr_getter
+      .asFunction<
+          GDExtensionPtrGetter Function(
+              int, GDExtensionConstStringNamePtr)>(isLeaf: true);
+  late final _variantGetPtrSetter = interface.ref.variant_get_ptr_setter
+      .asFunction<
+          GDExtensionPtrGetter Function(
+              int, GDExtensionConstStringNamePtr)>(isLeaf: true);
+  late final _variantGetPtrBuiltinMethod = interface
+      .ref.variant_get_ptr_builtin_method
+      .asFunction<
+          GDExtensionPtrBuiltInMethod Function(
+              int, GDExtensionConstStringNamePtr, int)>(isLeaf: true);
+  late final _variantGetType = interface.ref.variant_get_type
+      .asFunction<int Function(GDExtensionConstVariantPtr)>(isLeaf: true);
+  late final _variantNewNil = interface.ref.variant_new_nil
+      .asFunction<void Function(GDExtensionVariantPtr)>(isLeaf: true);
+  late final _globalGetSingleton = interface.ref.global_get_singleton
+      .asFunction<GDExtensionObjectPtr Function(GDExtensionConstStringNamePtr)>(
+          isLeaf: true);
+  late final _classDbGetMethodBind = interface.ref.classdb_get_method_bind
+      .asFunction<
+          GDExtensionMethodBindPtr Function(GDExtensionConstStringNamePtr,
+              GDExtensionConstStringNamePtr, int)>(isLeaf: true);
+  late final _packedByteArrayOperatorIndex = interface
+      .ref.packed_byte_array_operator_index
+      .asFunction<Pointer<Uint8> Function(GDExtensionTypePtr, int)>(
+          isLeaf: true);
+  late final _packedByteArrayOperatorIndexConst = interface
+      .ref.packed_byte_array_operator_index_const
+      .asFunction<Pointer<Uint8> Function(GDExtensionConstTypePtr, int)>(
+          isLeaf: true);
+  late final _packedInt32ArrayOperatorIndex = interface
+      .ref.packed_int32_array_operator_index
+      .asFunction<Pointer<Int32> Function(GDExtensionTypePtr, int)>(
+          isLeaf: true);
+  late final _packedInt32ArrayOperatorIndexConst = interface
+      .ref.packed_int32_array_operator_index_const
+      .asFunction<Pointer<Int32> Function(GDExtensionConstTypePtr, int)>(
+          isLeaf: true);
+  late final _packedInt64ArrayOperatorIndex = interface
+      .ref.packed_int64_array_operator_index
+      .asFunction<Pointer<Int64> Function(GDExtensionTypePtr, int)>(
+          isLeaf: true);
+  late final _packedInt64ArrayOperatorIndexConst = interface
+      .ref.packed_int64_array_operator_index_const
+      .asFunction<Pointer<Int64> Function(GDExtensionConstTypePtr, int)>(
+          isLeaf: true);
+  late final _packedFloat32ArrayOperatorIndex = interface
+      .ref.packed_float32_array_operator_index
+      .asFunction<Pointer<Float> Function(GDExtensionTypePtr, int)>(
+          isLeaf: true);
+  late final _packedFloat32ArrayOperatorIndexConst = interface
+      .ref.packed_float32_array_operator_index_const
+      .asFunction<Pointer<Float> Function(GDExtensionConstTypePtr, int)>(
+          isLeaf: true);
+  late final _packedFloat64ArrayOperatorIndex = interface
+      .ref.packed_float64_array_operator_index
+      .asFunction<Pointer<Double> Function(GDExtensionTypePtr, int)>(
+          isLeaf: true);
+  late final _packedFloat64ArrayOperatorIndexConst = interface
+      .ref.packed_float64_array_operator_index_const
+      .asFunction<Pointer<Double> Function(GDExtensionConstTypePtr, int)>(
+          isLeaf: true);
+  late final _packedVector2ArrayOperatorIndex = interface
+      .ref.packed_vector2_array_operator_index
+      .asFunction<GDExtensionTypePtr Function(GDExtensionTypePtr, int)>(
+          isLeaf: true);
+  late final _packedVector3ArrayOperatorIndex = interface
+      .ref.packed_vector3_array_operator_index
+      .asFunction<GDExtensionTypePtr Function(GDExtensionTypePtr, int)>(
+          isLeaf: true);
+  late final _packedColorArrayOperatorIndex = interface
+      .ref.packed_color_array_operator_index
+      .asFunction<GDExtensionTypePtr Function(GDExtensionTypePtr, int)>(
+          isLeaf: true);
+  late final _arrayOperatorIndexConst = interface
+      .ref.array_operator_index_const
+      .asFunction<
+          GDExtensionVariantPtr Function(
+              GDExtensionConstTypePtr, int)>(isLeaf: true);
+  late final _dictionaryOperatorIndexConst = interface
+      .ref.dictionary_operator_index_const
+      .asFunction<
+              GDExtensionVariantPtr Function(
+                  GDExtensionConstTypePtr, GDExtensionConstVariantPtr)>(
+          isLeaf: true);
+  // These can end up calling back into Dart, so they can't be leaf calls.
+  // Copying a Variant, copying an Array's elements when it's made unique or
+  // inserting a Dictionary key can all reference an Object.
+  late final _variantDestroy = interface.ref.variant_destroy
+      .asFunction<void Function(GDExtensionVariantPtr)>();
+  late final _variantNewCopy = interface.ref.variant_new_copy.asFunction<
+      void Function(GDExtensionVariantPtr, GDExtensionConstVariantPtr)>();
+  late final _arrayOperatorIndex = interface.ref.array_operator_index
+      .asFunction<GDExtensionVariantPtr Function(GDExtensionTypePtr, int)>();
+  late final _dictionaryOperatorIndex = interface
+      .ref.dictionary_operator_index
+      .asFunction<
+          GDExtensionVariantPtr Function(
+              GDExtensionTypePtr, GDExtensionConstVariantPtr)>();
+  late final _classDbConstructObject = interface.ref.classdb_construct_object
+      .asFunction<
+          GDExtensionObjectPtr Function(GDExtensionConstStringNamePtr)>();
+  late final _objectMethodBindPtrCall = interface
+      .ref.object_method_bind_ptrcall
+      .asFunction<
+          void Function(GDExtensionMethodBindPtr, GDExtensionObjectPtr,
+              Pointer<GDExtensionConstTypePtr>, GDExtensionTypePtr)>();
+  late final _objectMethodBindCall = interface.ref.object_method_bind_call
+      .asFunction<
+          void Function(
+              GDExtensionMethodBindPtr,
+              GDExtensionObjectPtr,
+              Pointer<GDExtensionConstVariantPtr>,
+              int,
+              GDExtensionVariantPtr,
+              Pointer<GDExtensionCallError>)>();
+
+  // Builtin constructors and methods are looked up per type, so their Dart
+  // functions are cached by address
+  final _builtinConstructors = <int,
+      void Function(GDExtensionTypePtr, Pointer<GDExtensionConstTypePtr>)>{};
+  // Addresses of the constructors of types that hold Objects, which can't be
+  // leaf calls
+  final _objectHoldingConstructors = <int>{};
+  final _builtinMethods = <int,
+      void Function(GDExtensionTypePtr, Pointer<GDExtensionConstTypePtr>,
+          GDExtensionTypePtr, int)>{};
+
+  /// Scratch memory for the arguments and return values of calls into Godot
+  final scratch = ScratchBuffer();
+
   GodotDart(this.interface, this.libraryPtr) {
     instance = this;
 
@@ -34,40 +184,134 @@ class GodotDart {
     int variantType,
     int index,
   ) {
-    GDExtensionPtrConstructor Function(int, int) func = interface
-        .ref.variant_get_ptr_constructor
-        .asFunction<GDExtensionPtrConstructor Function(int, int)>();
-    return func(variantType, index);
+    final constructor = _variantGetPtrConstructor(variantType, index);
+    if (variantTypeHoldsObjects(variantType)) {
+      _objectHoldingConstructors.add(constructor.address);
+    }
+    return constructor;
   }
 
   GDExtensionPtrDestructor variantGetDestructor(int variantType) {
-    return interface.ref.variant_get_ptr_destructor
-        .asFunction<GDExtensionPtrDestructor Function(int)>()(variantType);
+    return _variantGetPtrDestructor(variantType);
   }
 
   GDExtensionPtrGetter variantGetPtrGetter(int variantType, StringName name) {
-    return interface.ref.variant_get_ptr_getter.asFunction<
-            GDExtensionPtrGetter Function(int, GDExtensionConstStringNamePtr)>(
-        isLeaf: true)(variantType, name.nativePtr.cast());
+    return _variantGetPtrGetter(variantType, name.nativePtr.cast());
   }
 
   GDExtensionPtrGetter variantGetPtrSetter(int variantType, StringName name) {
-    return interface.ref.variant_get_ptr_setter.asFunction<
-            GDExtensionPtrGetter Function(int, GDExtensionConstStringNamePtr)>(
-        isLeaf: true)(variantType, name.nativePtr.cast());
+    return _variantGetPtrSetter(variantType, name.nativePtr.cast());
+  }
+
+  int variantGetType(GDExtensionConstVariantPtr variant) {
+    return _variantGetType(variant);
+  }
+
+  void variantNewNil(GDExtensionVariantPtr variant) {
+    _variantNewNil(variant);
+  }
+
+  void variantNewCopy(
+      GDExtensionVariantPtr dest, GDExtensionConstVariantPtr src) {
+    _variantNewCopy(dest, src);
+  }
+
+  void variantDestroy(GDExtensionVariantPtr variant) {
+    _variantDestroy(variant);
+  }
+
+  Pointer<Uint8> packedByteArrayOperatorIndex(
+      GDExtensionTypePtr array, int index) {
+    return _packedByteArrayOperatorIndex(array, index);
+  }
+
+  Pointer<Uint8> packedByteArrayOperatorIndexConst(
+      GDExtensionConstTypePtr array, int index) {
+    return _packedByteArrayOperatorIndexConst(array, index);
+  }
+
+  Pointer<Int32> packedInt32ArrayOperatorIndex(
+      GDExtensionTypePtr array, int index) {
+    return _packedInt32ArrayOperatorIndex(array, index);
+  }
+
+  Pointer<Int32> packedInt32ArrayOperatorIndexConst(
+      GDExtensionConstTypePtr array, int index) {
+    return _packedInt32ArrayOperatorIndexConst(array, index);
+  }
+
+  Pointer<Int64> packedInt64ArrayOperatorIndex(
+      GDExtensionTypePtr array, int index) {
+    return _packedInt64ArrayOperatorIndex(array, index);
+  }
+
+  Pointer<Int64> packedInt64ArrayOperatorIndexConst(
+      GDExtensionConstTypePtr array, int index) {
+    return _packedInt64ArrayOperatorIndexConst(array, index);
+  }
+
+  Pointer<Float> packedFloat32ArrayOperatorIndex(
+      GDExtensionTypePtr array, int index) {
+    return _packedFloat32ArrayOperatorIndex(array, index);
+  }
+
+  Pointer<Float> packedFloat32ArrayOperatorIndexConst(
+      GDExtensionConstTypePtr array, int index) {
+    return _packedFloat32ArrayOperatorIndexConst(array, index);
+  }
+
+  Pointer<Double> packedFloat64ArrayOperatorIndex(
+      GDExtensionTypePtr array, int index) {
+    return _packedFloat64ArrayOperatorIndex(array, index);
+  }
+
+  Pointer<Double> packedFloat64ArrayOperatorIndexConst(
+      GDExtensionConstTypePtr array, int index) {
+    return _packedFloat64ArrayOperatorIndexConst(array, index);
+  }
+
+  GDExtensionTypePtr packedVector2ArrayOperatorIndex(
+      GDExtensionTypePtr array, int index) {
+    return _packedVector2ArrayOperatorIndex(array, index);
+  }
+
+  GDExtensionTypePtr packedVector3ArrayOperatorIndex(
+      GDExtensionTypePtr array, int index) {
+    return _packedVector3ArrayOperatorIndex(array, index);
+  }
+
+  GDExtensionTypePtr packedColorArrayOperatorIndex(
+      GDExtensionTypePtr array, int index) {
+    return _packedColorArrayOperatorIndex(array, index);
+  }
+
+  GDExtensionVariantPtr arrayOperatorIndex(
+      GDExtensionTypePtr array, int index) {
+    return _arrayOperatorIndex(array, index);
+  }
+
+  GDExtensionVariantPtr arrayOperatorIndexConst(
+      GDExtensionConstTypePtr array, int index) {
+    return _arrayOperatorIndexConst(array, index);
+  }
+
+  GDExtensionVariantPtr dictionaryOperatorIndex(
+      GDExtensionTypePtr dictionary, GDExtensionConstVariantPtr key) {
+    return _dictionaryOperatorIndex(dictionary, key);
+  }
+
+  GDExtensionVariantPtr dictionaryOperatorIndexConst(
+      GDExtensionConstTypePtr dictionary, GDExtensionConstVariantPtr key) {
+    return _dictionaryOperatorIndexConst(dictionary, key);
   }
 
   GDExtensionObjectPtr globalGetSingleton(StringName name) {
-    return interface.ref.global_get_singleton.asFunction<
-            GDExtensionObjectPtr Function(GDExtensionConstStringNamePtr)>(
-        isLeaf: true)(name.nativePtr.cast());
+    return _globalGetSingleton(name.nativePtr.cast());
   }
 
   GDExtensionMethodBindPtr classDbGetMethodBind(
       StringName className, StringName methodName, int hash) {
-    return interface.ref.classdb_get_method_bind.asFunction<
-            GDExtensionMethodBindPtr Function(GDExtensionConstStringNamePtr,
-                GDExtensionConstStringNamePtr, int)>(isLeaf: true)(
+    return _classDbGetMethodBind(
         className.nativePtr.cast(), methodName.nativePtr.cast(), hash);
   }
 
@@ -76,16 +320,13 @@ class GodotDart {
     GDExtensionTypePtr base,
     List<GDExtensionConstTypePtr> args,
   ) {
-    final array = malloc<GDExtensionConstTypePtr>(args.length);
-    for (int i = 0; i < args.length; ++i) {
-      array[i] = args[i];
-    }
-
-    void Function(GDExtensionTypePtr, Pointer<GDExtensionConstTypePtr>) c =
-        constructor.asFunction();
-    c(base, array);
-
-    malloc.free(array);
+    final c = _builtinConstructors[constructor.address] ??=
+        _objectHoldingConstructors.contains(constructor.address)
+            ? constructor.asFunction()
+            : constructor.asFunction(isLeaf: true);
+    scratch.scope((arena) {
+      c(base, _argumentArray(arena, args));
+    });
   }
 
   void callBuiltinMethodPtr(
@@ -96,13 +337,10 @@ class GodotDart {
   ) {
     if (method == null) return;
 
-    final array = malloc<GDExtensionConstTypePtr>(args.length);
-    for (int i = 0; i < args.length; ++i) {
-      array[i] = args[i];
-    }
-    void Function(GDExtensionTypePtr, Pointer<GDExtensionConstTypePtr>,
-        GDExtensionTypePtr, int) m = method.asFunction();
-    m(base, array, ret, args.length);
+    final m = _builtinMethods[method.address] ??= method.asFunction();
+    scratch.scope((arena) {
+      m(base, _argumentArray(arena, args), ret, args.length);
+    });
   }
 
   void callNativeMethodBindPtrCall(
@@ -111,52 +349,60 @@ class GodotDart {
     Pointer<Void> ret,
     List<GDExtensionConstTypePtr> args,
   ) {
-    final callFunc = interface.ref.object_method_bind_ptrcall.asFunction<
-        void Function(GDExtensionMethodBindPtr, GDExtensionObjectPtr,
-            Pointer<GDExtensionConstTypePtr>, GDExtensionTypePtr)>();
-
-    using((arena) {
-      final argArray = arena.allocate<GDExtensionConstTypePtr>(
-          sizeOf<GDExtensionConstTypePtr>() * args.length);
-      for (int i = 0; i < args.length; ++i) {
-        argArray.elementAt(i).value = args[i];
-      }
-
-      callFunc(function, instance?.nativePtr ?? nullptr, argArray, ret);
+    scratch.scope((arena) {
+      _objectMethodBindPtrCall(function, instance?.nativePtr ?? nullptr,
+          _argumentArray(arena, args), ret);
     });
   }
 
-  Variant callNativeMethodBind(
+  /// Call [function] with [args] converted to Variants, and return the result
+  /// converted back to Dart.
+  ///
+  /// The arguments and the return value are packed into one [VariantList] in
+  /// scratch memory, so the call makes no per argument allocations.
+  Object? callNativeMethodBind(
     GDExtensionMethodBindPtr function,
     ExtensionType? instance,
-    List<Variant> args,
-  ) {
-    final callFunc = interface.ref.object_method_bind_call.asFunction<
-        void Function(
-            GDExtensionMethodBindPtr,
-            GDExtensionObjectPtr,
-            Pointer<GDExtensionConstVariantPtr>,
-            int,
-            GDExtensionVariantPtr,
-            Pointer<GDExtensionCallError>)>();
-    final ret = Variant();
-    using((arena) {
-      final errorPtr =
-          arena.allocate<GDExtensionCallError>(sizeOf<GDExtensionCallError>());
-      final argArray = arena.allocate<GDExtensionConstTypePtr>(
-          sizeOf<GDExtensionConstVariantPtr>() * args.length);
-      for (int i = 0; i < args.length; ++i) {
-        argArray.elementAt(i).value = args[i].nativePtr.cast();
-      }
-      callFunc(function, instance?.nativePtr.cast() ?? nullptr.cast(), argArray,
-          args.length, ret.nativePtr.cast(), errorPtr.cast());
-      if (errorPtr.ref.error != GDExtensionCallErrorType.GDEXTENSION_CALL_OK) {
-        throw Exception(
-            'Error calling function in Godot: Error ${errorPtr.ref.error}, Argument ${errorPtr.ref.argument}, Expected ${errorPtr.ref.expected}');
+    List<Object?> args, [
+    Pointer<GDExtensionInstanceBindingCallbacks>? bindingCallbacks,
+  ]) {
+    return scratch.scope((arena) {
+      // The last element holds the return value
+      final variants = VariantList(args.length + 1, arena);
+      try {
+        final errorPtr = arena
+            .allocate<GDExtensionCallError>(sizeOf<GDExtensionCallError>());
+        final argArray = arena<GDExtensionConstVariantPtr>(args.length);
+        for (int i = 0; i < args.length; ++i) {
+          variants[i] = args[i];
+          argArray[i] = variants.elementPtr(i);
+        }
+        _objectMethodBindCall(
+            function,
+            instance?.nativePtr.cast() ?? nullptr.cast(),
+            argArray,
+            args.length,
+            variants.elementPtr(args.length),
+            errorPtr.cast());
+        if (errorPtr.ref.error !=
+            GDExtensionCallErrorType.GDEXTENSION_CALL_OK) {
+          throw Exception(
+              'Error calling function in Godot: Error ${errorPtr.ref.error}, Argument ${errorPtr.ref.argument}, Expected ${errorPtr.ref.expected}');
+        }
+        return variants.toDart(args.length, bindingCallbacks);
+      } finally {
+        variants.destroy();
       }
     });
+  }
 
-    return ret;
+  Pointer<GDExtensionConstTypePtr> _argumentArray(
+      Allocator allocator, List<GDExtensionConstTypePtr> args) {
+    final array = allocator<GDExtensionConstTypePtr>(args.length);
+    for (int i = 0; i < args.length; ++i) {
+      array[i] = args[i];
+    }
+    return array;
   }
 
   GDExtensionPtrBuiltInMethod variantGetBuiltinMethod(
@@ -164,14 +410,11 @@ class GodotDart {
     StringName name,
     int hash,
   ) {
-    return interface.ref.variant_get_ptr_builtin_method.asFunction<
-        GDExtensionPtrBuiltInMethod Function(int, GDExtensionConstStringNamePtr,
-            int)>()(variantType, name.nativePtr.cast(), hash);
+    return _variantGetPtrBuiltinMethod(
+        variantType, name.nativePtr.cast(), hash);
   }
 
   GDExtensionObjectPtr constructObject(StringName className) {
-    final func = interface.ref.classdb_construct_object.asFunction<
-        GDExtensionObjectPtr Function(GDExtensionConstStringNamePtr)>();
-    return func(className.nativePtr.cast());
+    return _classDbConstructObject(className.nativePtr.cast());
   }
 }
@@ -0,0 +1,143 @@
+import 'dart:ffi';
+
+import 'package:ffi/ffi.dart';
+
+import 'gdextension.dart';
+import 'gdextension_ffi_bindings.dart';
+import 'scratch_buffer.dart';
+
+/// Storage for builtin temporaries, like the Strings, StringNames and Arrays
+/// created while handling a frame.
+///
+/// Builtins normally allocate their storage with calloc and free it from a
+/// finalizer, which leaves every temporary to the garbage collector. Inside
+/// [frameScope] they are allocated from a bump arena instead, without a
+/// finalizer, and all of them are destroyed and released together when the
+/// scope returns:
+///
+/// ```dart
+/// @override
+/// void vProcess(double delta) {
+///   GodotArena.frameScope(() {
+///     final name = StringName.fromString('health');
+///     ...
+///   });
+/// }
+/// ```
+///
+/// Builtins created in a frame scope must not outlive it. Create values that
+/// are kept, such as ones stored in fields or statics initialized on first
+/// use, with [persist], or copy them with [persist] before the scope returns.
+/// [TypeInfo], which is usually kept in a static, copies names that were
+/// created in a frame scope itself.
+abstract class GodotArena {
+  static const int _capacity = 256 * 1024;
+
+  static final _arena = ScratchBuffer(_capacity);
+  static bool _active = false;
+
+  // Builtins allocated in the active frame scopes that have a destructor, in
+  // the order they were allocated
+  static final _pendingStorage = <Pointer<Uint8>>[];
+  static final _pendingDestructors = <void Function(GDExtensionTypePtr)>[];
+
+  // Destructors by variant type, null for types that don't have one
+  static final _destructors = <int, void Function(GDExtensionTypePtr)?>{};
+
+  /// Run [computation] with the builtins it creates allocated from the frame
+  /// arena, destroying and releasing them when it returns. Nested scopes
+  /// release what they allocated when they return.
+  static R frameScope<R>(R Function() computation) {
+    final wasActive = _active;
+    final pending = _pendingStorage.length;
+    _active = true;
+    try {
+      return _arena.scope((_) {
+        try {
+          return computation();
+        } finally {
+          _destroyFrom(pending);
+        }
+      });
+    } finally {
+      _active = wasActive;
+    }
+  }
+
+  /// Run [computation] with the builtins it creates allocated normally, even
+  /// inside a [frameScope].
+  static R persist<R>(R Function() computation) {
+    final wasActive = _active;
+    _active = false;
+    try {
+      return computation();
+    } finally {
+      _active = wasActive;
+    }
+  }
+
+  /// Whether builtins created now are allocated from the frame arena.
+  static bool get isActive => _active;
+
+  /// Allocate the storage of a builtin of [variantType], from the frame arena
+  /// if one is active. The builtin is then destroyed when the scope returns.
+  static Pointer<Uint8> allocate(int size, int variantType) {
+    if (!_active) {
+      return calloc<Uint8>(size);
+    }
+
+    final ptr = _arena.allocate<Uint8>(size);
+    final destructor = _destructors.containsKey(variantType)
+        ? _destructors[variantType]
+        : _resolveDestructor(variantType);
+    if (destructor != null) {
+      _pendingStorage.add(ptr);
+      _pendingDestructors.add(destructor);
+    }
+    return ptr;
+  }
+
+  /// Whether [pointer] was just allocated from the frame arena, so the builtin
+  /// it belongs to must not free it.
+  static bool owns(Pointer<NativeType> pointer) =>
+      _active && _arena.owns(pointer);
+
+  /// Stop destroying the builtin at [pointer] when its frame scope returns,
+  /// because its value was moved to storage owned by someone else.
+  static void release(Pointer<NativeType> pointer) {
+    if (!_arena.owns(pointer)) return;
+    // Values are usually moved right after they are created, so search from
+    // the end
+    for (var i = _pendingStorage.length - 1; i >= 0; --i) {
+      if (_pendingStorage[i].address == pointer.address) {
+        // Entries stay in place, as enclosing scopes track them by index
+        _pendingDestructors[i] = _skipDestructor;
+        return;
+      }
+    }
+  }
+
+  static void _skipDestructor(GDExtensionTypePtr ptr) {}
+
+  // Destroy the builtins allocated since [pending] builtins were, latest
+  // first
+  static void _destroyFrom(int pending) {
+    while (_pendingStorage.length > pending) {
+      final destructor = _pendingDestructors.removeLast();
+      destructor(_pendingStorage.removeLast().cast());
+    }
+  }
+
+  static void Function(GDExtensionTypePtr)? _resolveDestructor(
+      int variantType) {
+    final destructor = gde.variantGetDestructor(variantType);
+    void Function(GDExtensionTypePtr)? function;
+    if (destructor != nullptr) {
+      // Destroying a container can release the Objects it holds
+      function = variantTypeHoldsObjects(variantType)
+          ? destructor.asFunction()
+          : destructor.asFunction(isLeaf: true);
+    }
+    return _destructors[variantType] = function;
+  }
+}
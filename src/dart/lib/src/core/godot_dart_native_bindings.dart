@@ -1,35 +1,86 @@
+import 'dart:convert';
 import 'dart:ffi';
 import 'dart:io';
 
+import 'package:ffi/ffi.dart';
 import 'package:path/path.dart' as path;
 
 import '../../godot_dart.dart';
 import 'gdextension_ffi_bindings.dart';
 
+// These are bound through the library's FFI native resolver (see
+// `ffi_native_resolver` in dart_bindings.cpp) rather than a symbol lookup.
+@FfiNative<Void Function(Pointer<Void>, Pointer<Void>, Int32)>('variant_copy',
+    isLeaf: true)
+external void _variantCopy(Pointer<Void> dest, Pointer<Void> src, int size);
+
+@FfiNative<Bool Function(Uint64, Pointer<Utf8>, Pointer<Void>)>(
+    'godot_dart_copy_interned_string_name',
+    isLeaf: true)
+external bool _copyInternedStringName(
+    int hash, Pointer<Utf8> cstr, Pointer<Void> out);
+
+@FfiNative<
+        Void Function(Pointer<Pointer<Utf8>>, Pointer<Uint64>, Size,
+            Pointer<Pointer<Uint8>>)>('godot_dart_intern_string_names',
+    isLeaf: true)
+external void _internStringNames(Pointer<Pointer<Utf8>> names,
+    Pointer<Uint64> hashes, int count, Pointer<Pointer<Uint8>> out);
+
+// Pack [strings] as a native array of null terminated UTF-8 strings
+Pointer<Pointer<Utf8>> _packUtf8(List<String> strings, Allocator allocator) {
+  final packed = allocator<Pointer<Utf8>>(strings.length);
+  for (var i = 0; i < strings.length; ++i) {
+    packed[i] = strings[i].toNativeUtf8(allocator: allocator);
+  }
+  return packed;
+}
+
+@FfiNative<Pointer<Void> Function(Handle)>('godot_dart_new_instance_handle')
+external Pointer<Void> _newInstanceHandle(Object object);
+
+@FfiNative<Handle Function(Pointer<Void>)>('godot_dart_get_instance_handle')
+external Object? _getInstanceHandle(Pointer<Void> handle);
+
+@FfiNative<Handle Function(Pointer<Void>)>('godot_dart_gd_string_to_string')
+external Object _gdStringToString(Pointer<Void> gdString);
+
+@FfiNative<Handle Function(Handle, Pointer<Void>)>(
+    'godot_dart_string_to_gd_string')
+external Object? _stringToGDString(String string, Pointer<Void> dest);
+
+@FfiNative<Handle Function(Pointer<Void>, Pointer<Void>)>(
+    'godot_dart_gd_object_to_dart_object')
+external Object? _gdObjectToDartObject(
+    Pointer<Void> object, Pointer<Void> bindingCallbacks);
+
+@FfiNative<Handle Function(Pointer<Void>, Pointer<Void>)>(
+    'godot_dart_ref_to_dart_object')
+external Object? _refToDartObject(
+    Pointer<Void> object, Pointer<Void> bindingCallbacks);
+
+@FfiNative<Handle Function(Handle, Pointer<Void>, Pointer<Void>)>(
+    'godot_dart_post_initialize')
+external Object? _postInitialize(
+    Object object, Pointer<Void> owner, Pointer<Void> typeName);
+
 class GodotDartNativeBindings {
   late final DynamicLibrary dartDylib;
   late final DynamicLibrary godotDartDylib;
 
-  late final _newPersistentHandle = dartDylib
-      .lookup<NativeFunction<Pointer<Void> Function(Handle)>>(
-          'Dart_NewPersistentHandle')
-      .asFunction<Pointer<Void> Function(Object)>();
-  late final _handleFromPersistent = dartDylib
-      .lookup<NativeFunction<Handle Function(Pointer<Void>)>>(
-          'Dart_HandleFromPersistent')
-      .asFunction<Object? Function(Pointer<Void>)>();
-  late final _deletePersistentHandle = dartDylib
-      .lookup<NativeFunction<Void Function(Pointer<Void>)>>(
-          'Dart_DeletePersistentHandle')
-      .asFunction<void Function(Pointer<Void>)>();
-
-  late final _variantCopy = godotDartDylib
-      .lookup<
-          NativeFunction<
-              Void Function(
-                  Pointer<Void>, Pointer<Void>, Int32)>>('variant_copy')
-      .asFunction<void Function(Pointer<Void>, Pointer<Void>, int size)>(
-          isLeaf: true);
+  late final _setNativeInstanceField = dartDylib
+      .lookup<NativeFunction<Handle Function(Handle, Int, IntPtr)>>(
+          'Dart_SetNativeInstanceField')
+      .asFunction<Object Function(Object, int, int)>();
+
+  /// Binding callbacks that release an instance handle when Godot frees the
+  /// object, and track whether RefCounted objects are still referenced by
+  /// Godot.
+  late final GDExtensionInstanceBindingFreeCallback bindingFreeCallback =
+      godotDartDylib.lookup('godot_dart_binding_free_callback');
+  late final GDExtensionInstanceBindingReferenceCallback
+      bindingReferenceCallback =
+      godotDartDylib.lookup('godot_dart_binding_reference_callback');
 
   static DynamicLibrary openLibrary(String libName) {
     var libraryPath = path.join(Directory.current.path, '$libName.so');
@@ -57,31 +108,100 @@ class GodotDartNativeBindings {
   external void bindMethod(TypeInfo typeInfo, String methodName,
       TypeInfo returnType, List<TypeInfo> argTypes);
 
-  @pragma('vm:external-name', 'GodotDartNativeBindings::gdStringToString')
-  external String gdStringToString(GDString string);
+  String gdStringToString(GDString string) {
+    return _gdStringToString(string.nativePtr.cast()) as String;
+  }
 
-  @pragma('vm:external-name', 'GodotDartNativeBindings::gdObjectToDartObject')
-  external Object? gdObjectToDartObject(GDExtensionObjectPtr object,
-      Pointer<GDExtensionInstanceBindingCallbacks>? bindingCallbacks);
+  /// Construct a Godot String from [string] at [dest], which must point to
+  /// uninitialized (or empty) String storage.
+  void stringToGDString(String string, Pointer<Void> dest) {
+    _stringToGDString(string, dest);
+  }
+
+  Object? gdObjectToDartObject(GDExtensionObjectPtr object,
+      Pointer<GDExtensionInstanceBindingCallbacks>? bindingCallbacks) {
+    return _gdObjectToDartObject(object, bindingCallbacks?.cast() ?? nullptr);
+  }
 
-  Pointer<Void> toPersistentHandle(Object instance) {
-    return _newPersistentHandle(instance);
+  /// Like [gdObjectToDartObject], for a RefCounted [object] returned with a
+  /// reference the caller owns (a `Ref<T>` return from a ptrcall). That
+  /// reference is released once the Dart object holds its own.
+  Object? refToDartObject(GDExtensionObjectPtr object,
+      Pointer<GDExtensionInstanceBindingCallbacks>? bindingCallbacks) {
+    return _refToDartObject(object, bindingCallbacks?.cast() ?? nullptr);
   }
 
-  Object? fromPersistentHandle(Pointer<Void> handle) {
-    return _handleFromPersistent(handle);
+  /// Bind [object] to its owner as an instance of its [ExtensionType.staticTypeInfo].
+  void postInitialize(ExtensionType object) {
+    _postInitialize(object, object.nativePtr,
+        object.staticTypeInfo.className.nativePtr.cast());
   }
 
-  Object? clearPersistentHandle(Pointer<Void> handle) {
-    final obj = _handleFromPersistent(handle);
-    if (obj != null) {
-      _deletePersistentHandle(handle);
+  /// Create a handle for [instance] to give to Godot as an instance binding.
+  /// The handle is released by [bindingFreeCallback].
+  Pointer<Void> newInstanceHandle(Object instance) {
+    return _newInstanceHandle(instance);
+  }
+
+  Object? fromInstanceHandle(Pointer<Void> handle) {
+    return _getInstanceHandle(handle);
+  }
+
+  /// Copy the process-wide interned StringName for [name] into [out], which
+  /// must be uninitialized StringName storage. [hash] is [stringNameHash] of
+  /// [name], which the binding generator precomputes for literal names.
+  ///
+  /// Returns false if the name could not be interned, in which case [out] is
+  /// left untouched.
+  bool copyInternedStringName(String name, int? hash, Pointer<Uint8> out) {
+    hash ??= stringNameHash(name);
+    if (_copyInternedStringName(hash, nullptr, out.cast())) {
+      return true;
     }
-    return obj;
+
+    final native = name.toNativeUtf8();
+    final copied = _copyInternedStringName(hash, native, out.cast());
+    malloc.free(native);
+    return copied;
+  }
+
+  /// Intern every name in [names] with one native call and return an array
+  /// with a pointer to each interned StringName, to wrap with
+  /// `StringName.unowned`. [hashes] are the [stringNameHash]es of [names].
+  ///
+  /// The StringNames are owned by the extension and destroyed when it shuts
+  /// down. The array is never freed, it lives as long as they do.
+  Pointer<Pointer<Uint8>> internStringNames(
+      List<String> names, List<int> hashes) {
+    final interned = calloc<Pointer<Uint8>>(names.length);
+    using((arena) {
+      final nativeHashes = arena<Uint64>(names.length);
+      for (var i = 0; i < names.length; ++i) {
+        nativeHashes[i] = hashes[i];
+      }
+      _internStringNames(
+          _packUtf8(names, arena), nativeHashes, names.length, interned);
+    });
+    return interned;
   }
 
+  /// Store the native pointer of [object] in its native field ahead of it
+  /// being handed to the native side.
+  void setNativePointer(BuiltinType object) {
+    _setNativeInstanceField(object, 0, object.nativePtr.address);
+  }
+
+  /// Move the value of [src] to [dest]. This is a shallow copy, so a builtin
+  /// from a frame scope must no longer be destroyed along with the scope.
   void variantCopyToNative(Pointer<Void> dest, BuiltinType src) {
-    _variantCopy(dest, src.nativePtr.cast(), src.staticTypeInfo.size);
+    if (src is BuiltinValueType) {
+      src.copyToNative(dest);
+      return;
+    }
+
+    final srcPtr = src.nativePtr;
+    _variantCopy(dest, srcPtr.cast(), src.staticTypeInfo.size);
+    GodotArena.release(srcPtr);
   }
 
   void variantCopyFromNative(BuiltinType dest, Pointer<Void> src) {
@@ -89,19 +209,37 @@ class GodotDartNativeBindings {
   }
 }
 
+/// 64-bit FNV-1a hash of the UTF-8 encoding of [name], matching
+/// `gd_string_name_hash` on the native side.
+int stringNameHash(String name) {
+  var hash = 0xcbf29ce484222325;
+  for (final byte in utf8.encode(name)) {
+    hash ^= byte;
+    hash *= 0x100000001b3;
+  }
+  return hash;
+}
+
 // Potentially move this, just here for convenience
 @pragma('vm:entry-point')
 Variant _convertToVariant(Object? object) {
-  return convertToVariant(object);
+  final variant = convertToVariant(object);
+  gde.dartBindings.setNativePointer(variant);
+  return variant;
 }
 
+// Addresses come in as integers, with null for no binding callbacks
 @pragma('vm:entry-point')
-List<Object?> _variantsToDart(Pointer<Pointer<Void>> variants, int count,
-    List<Pointer<Void>?> bindingCallbacks) {
+List<Object?> _variantsToDart(
+    int variantsAddress, int count, List<Object?> bindingCallbacks) {
+  final variants = Pointer<Pointer<Void>>.fromAddress(variantsAddress);
   var result = <Object?>[];
   for (int i = 0; i < count; ++i) {
-    var variant = Variant.fromPointer(variants.elementAt(i).value);
-    result.add(convertFromVariant(variant, bindingCallbacks[i]?.cast()));
+    final callbacksAddress = bindingCallbacks[i] as int?;
+    final callbacks =
+        callbacksAddress == null ? null : Pointer.fromAddress(callbacksAddress);
+    result.add(
+        convertVariantPtrToDart(variants.elementAt(i).value, callbacks?.cast()));
   }
 
   return result;
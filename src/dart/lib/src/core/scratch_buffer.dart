@@ -0,0 +1,87 @@
+import 'dart:ffi';
+
+import 'package:ffi/ffi.dart';
+
+/// A bump allocator for the short lived buffers of calls into Godot: argument
+/// arrays, argument values and return slots.
+///
+/// Memory is handed out from one block allocated up front and is reclaimed in
+/// bulk when the enclosing [scope] returns, so steady state calls don't malloc
+/// or free at all. Scopes nest, which keeps the buffers of a call valid while
+/// Godot calls back into Dart and that code makes calls of its own.
+///
+/// Allocations are zeroed and 8 byte aligned. [free] does nothing, memory is
+/// only released by leaving the scope it was allocated in.
+class ScratchBuffer implements Allocator {
+  static const int _defaultCapacity = 64 * 1024;
+
+  final int _capacity;
+  final Pointer<Int64> _base;
+  int _top = 0;
+  int _depth = 0;
+
+  // Allocations that didn't fit in the block, freed with their scope, and
+  // their addresses for [owns]
+  final _overflow = <Pointer<NativeType>>[];
+  final _overflowAddresses = <int>{};
+
+  ScratchBuffer([int capacity = _defaultCapacity])
+      : _capacity = capacity,
+        _base = malloc<Int64>(capacity ~/ sizeOf<Int64>());
+
+  /// Whether a [scope] is running, so memory allocated now is reclaimed.
+  bool get inScope => _depth > 0;
+
+  /// Whether [pointer] was allocated by this buffer and not yet released.
+  bool owns(Pointer<NativeType> pointer) {
+    final offset = pointer.address - _base.address;
+    if (offset >= 0 && offset < _top * sizeOf<Int64>()) {
+      return true;
+    }
+    return _overflowAddresses.contains(pointer.address);
+  }
+
+  /// Run [computation] with this buffer as its allocator, releasing everything
+  /// it allocated when it returns.
+  R scope<R>(R Function(Allocator allocator) computation) {
+    final top = _top;
+    final overflow = _overflow.length;
+    _depth++;
+    try {
+      return computation(this);
+    } finally {
+      _depth--;
+      _top = top;
+      while (_overflow.length > overflow) {
+        final ptr = _overflow.removeLast();
+        _overflowAddresses.remove(ptr.address);
+        calloc.free(ptr);
+      }
+    }
+  }
+
+  @override
+  Pointer<T> allocate<T extends NativeType>(int byteCount, {int? alignment}) {
+    // Outside of a scope nothing would ever reclaim the memory
+    assert(_depth > 0, 'ScratchBuffer used outside of a scope');
+    // Work in whole 8 byte words, which covers the alignment of every type
+    // passed to Godot and lets the memory be cleared a word at a time
+    final words = (byteCount + 7) >> 3;
+    final start = _top;
+    if (start + words > _capacity >> 3) {
+      final ptr = calloc.allocate<T>(byteCount);
+      _overflow.add(ptr);
+      _overflowAddresses.add(ptr.address);
+      return ptr;
+    }
+
+    _top = start + words;
+    for (var i = start; i < _top; ++i) {
+      _base[i] = 0;
+    }
+    return _base.elementAt(start).cast();
+  }
+
+  @override
+  void free(Pointer<NativeType> pointer) {}
+}
@@ -3,6 +3,7 @@ import 'dart:ffi';
 import '../../godot_dart.dart';
 import '../gen/variant/string_name.dart';
 import 'gdextension_ffi_bindings.dart';
+import 'godot_dart_native_bindings.dart';
 
 /// [TypeInfo] contains information about the type meant to send to Godot
 /// binding methods. Because Type.toString() in Dart doesn't have to return the
@@ -12,16 +13,22 @@ import 'gdextension_ffi_bindings.dart';
 /// (Object.typeInfo) but for classes you create, you will need to add it.
 ///
 /// For Dart builtin types, use [TypeInfo.forType]
+///
+/// The native side reads the fields marked as entry points by name, so they
+/// have to be kept in AOT builds.
 class TypeInfo {
   /// The name of the class
+  @pragma('vm:entry-point', 'get')
   final StringName className;
 
   /// The Parent Class of the class
+  @pragma('vm:entry-point', 'get')
   final StringName? parentClass;
 
   /// The Variant type of this class. This is set to
   /// [GDExtensionVariantType.GDEXTENSION_VARIANT_TYPE_OBJECT] by default which
   /// is usually correct for most user created classes
+  @pragma('vm:entry-point', 'get')
   final int variantType;
 
   /// The size of the variant type. Zero for non-variants
@@ -29,37 +36,62 @@ class TypeInfo {
 
   /// Callbacks that create the proper Dart type from the C type. Mostly
   /// only used by core engine classes. Pass null to use the default.
+  @pragma('vm:entry-point', 'get')
   final Pointer<GDExtensionInstanceBindingCallbacks>? bindingCallbacks;
 
+  /// How many freed instances of this class are kept to be reused when Godot
+  /// creates a new one. Zero (the default) disables pooling.
+  ///
+  /// Reused instances are not constructed again, instead
+  /// [ExtensionType.resetForReuse] is called on them. Pooling is only
+  /// supported for classes whose [parentClass] is an engine class, binding
+  /// any other class with a pool prints a warning and disables it.
+  @pragma('vm:entry-point', 'get')
+  final int poolSize;
+
   TypeInfo(
-    this.className, {
-    this.parentClass,
+    StringName className, {
+    StringName? parentClass,
     this.variantType = GDExtensionVariantType.GDEXTENSION_VARIANT_TYPE_OBJECT,
     this.size = 0,
     this.bindingCallbacks,
-  });
+    this.poolSize = 0,
+  })  : className = _keep(className),
+        parentClass = parentClass == null ? null : _keep(parentClass);
+
+  // TypeInfos usually live in statics, which can be initialized inside a
+  // frame scope, so names from one are copied out of it
+  static StringName _keep(StringName name) => GodotArena.owns(name.nativePtr)
+      ? GodotArena.persist(() => StringName.copy(name))
+      : name;
 
   static late Map<Type?, TypeInfo> _typeMapping;
   static void initTypeMappings() {
+    const typeNames = ['void', 'bool', 'int', 'double', 'String'];
+    final interned = gde.dartBindings.internStringNames(
+        typeNames, typeNames.map(stringNameHash).toList());
+    final names = List.generate(
+        typeNames.length, (i) => StringName.unowned(interned[i]),
+        growable: false);
     _typeMapping = {
       null: TypeInfo(
-        StringName.fromString('void'),
+        names[0],
         variantType: GDExtensionVariantType.GDEXTENSION_VARIANT_TYPE_NIL,
       ),
       bool: TypeInfo(
-        StringName.fromString('bool'),
+        names[1],
         variantType: GDExtensionVariantType.GDEXTENSION_VARIANT_TYPE_BOOL,
       ),
       int: TypeInfo(
-        StringName.fromString('int'),
+        names[2],
         variantType: GDExtensionVariantType.GDEXTENSION_VARIANT_TYPE_INT,
       ),
       double: TypeInfo(
-        StringName.fromString('double'),
+        names[3],
         variantType: GDExtensionVariantType.GDEXTENSION_VARIANT_TYPE_FLOAT,
       ),
       String: TypeInfo(
-        StringName.fromString('String'),
+        names[4],
         variantType: GDExtensionVariantType.GDEXTENSION_VARIANT_TYPE_STRING,
       ),
     };
@@ -5,9 +5,10 @@ import '../../godot_dart.dart';
 class DartScript extends ScriptExtension {
   static late TypeInfo typeInfo;
   static void initTypeInfo() => typeInfo = TypeInfo(
-        StringName.fromString('DartScript'),
+        StringName.interned('DartScript'),
         parentClass: ScriptExtension.typeInfo.className,
       );
+  @pragma('vm:entry-point')
   static Map<String, Pointer<GodotVirtualFunction>> get vTable =>
       ScriptExtension.vTable;
 
@@ -19,6 +20,7 @@ class DartScript extends ScriptExtension {
     gde.dartBindings.bindClass(DartScript, DartScript.typeInfo);
   }
 
+  @pragma('vm:entry-point')
   DartScript() : super() {
     postInitialize();
   }
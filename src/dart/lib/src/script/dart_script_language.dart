@@ -6,12 +6,14 @@ import 'dart_script.dart';
 class DartScriptLanguage extends ScriptLanguageExtension {
   static late TypeInfo typeInfo;
   static void initTypeInfo() => typeInfo = TypeInfo(
-        StringName.fromString('DartScriptLanguage'),
+        StringName.interned('DartScriptLanguage'),
         parentClass: ScriptLanguageExtension.typeInfo.className,
       );
+  @pragma('vm:entry-point')
   static Map<String, Pointer<GodotVirtualFunction>> get vTable =>
       ScriptLanguageExtension.vTable;
 
+  @pragma('vm:entry-point')
   DartScriptLanguage() : super() {
     postInitialize();
   }
@@ -68,9 +70,10 @@ class $strClassName extends $baseClassName {
   // This is necessary boilerplate at the moment
   static late TypeInfo typeInfo;
   static void initTypeInfo() => typeInfo = TypeInfo(
-        StringName.fromString('DartScript'),
+        StringName.interned('DartScript'),
         parentClass: Script.typeInfo.className,
       );
+  @pragma('vm:entry-point')
   static Map<String, Pointer<GodotVirtualFunction>> get vTable => $baseClassName.vTable;
 
   @override
@@ -0,0 +1,176 @@
+import 'dart:typed_data';
+
+import '../../godot_dart.dart';
+import '../core/gdextension_ffi_bindings.dart';
+
+// Conversions between Dart collections and Godot's Array, Dictionary and
+// packed arrays. Typed data is copied in bulk through the packed array's
+// storage, never element by element.
+
+extension Uint8ListToGodot on Uint8List {
+  PackedByteArray toPackedArray() {
+    final array = PackedByteArray()..resize(length);
+    if (isNotEmpty) {
+      gde
+          .packedByteArrayOperatorIndex(array.nativePtr.cast(), 0)
+          .asTypedList(length)
+          .setAll(0, this);
+    }
+    return array;
+  }
+}
+
+extension Int32ListToGodot on Int32List {
+  PackedInt32Array toPackedArray() {
+    final array = PackedInt32Array()..resize(length);
+    if (isNotEmpty) {
+      gde
+          .packedInt32ArrayOperatorIndex(array.nativePtr.cast(), 0)
+          .asTypedList(length)
+          .setAll(0, this);
+    }
+    return array;
+  }
+}
+
+extension Int64ListToGodot on Int64List {
+  PackedInt64Array toPackedArray() {
+    final array = PackedInt64Array()..resize(length);
+    if (isNotEmpty) {
+      gde
+          .packedInt64ArrayOperatorIndex(array.nativePtr.cast(), 0)
+          .asTypedList(length)
+          .setAll(0, this);
+    }
+    return array;
+  }
+}
+
+extension Float32ListToGodot on Float32List {
+  PackedFloat32Array toPackedArray() {
+    final array = PackedFloat32Array()..resize(length);
+    if (isNotEmpty) {
+      gde
+          .packedFloat32ArrayOperatorIndex(array.nativePtr.cast(), 0)
+          .asTypedList(length)
+          .setAll(0, this);
+    }
+    return array;
+  }
+}
+
+extension Float64ListToGodot on Float64List {
+  PackedFloat64Array toPackedArray() {
+    final array = PackedFloat64Array()..resize(length);
+    if (isNotEmpty) {
+      gde
+          .packedFloat64ArrayOperatorIndex(array.nativePtr.cast(), 0)
+          .asTypedList(length)
+          .setAll(0, this);
+    }
+    return array;
+  }
+}
+
+extension PackedByteArrayToDart on PackedByteArray {
+  Uint8List toUint8List() {
+    final length = size();
+    if (length == 0) return Uint8List(0);
+    return Uint8List.fromList(gde
+        .packedByteArrayOperatorIndexConst(nativePtr.cast(), 0)
+        .asTypedList(length));
+  }
+}
+
+extension PackedInt32ArrayToDart on PackedInt32Array {
+  Int32List toInt32List() {
+    final length = size();
+    if (length == 0) return Int32List(0);
+    return Int32List.fromList(gde
+        .packedInt32ArrayOperatorIndexConst(nativePtr.cast(), 0)
+        .asTypedList(length));
+  }
+}
+
+extension PackedInt64ArrayToDart on PackedInt64Array {
+  Int64List toInt64List() {
+    final length = size();
+    if (length == 0) return Int64List(0);
+    return Int64List.fromList(gde
+        .packedInt64ArrayOperatorIndexConst(nativePtr.cast(), 0)
+        .asTypedList(length));
+  }
+}
+
+extension PackedFloat32ArrayToDart on PackedFloat32Array {
+  Float32List toFloat32List() {
+    final length = size();
+    if (length == 0) return Float32List(0);
+    return Float32List.fromList(gde
+        .packedFloat32ArrayOperatorIndexConst(nativePtr.cast(), 0)
+        .asTypedList(length));
+  }
+}
+
+extension PackedFloat64ArrayToDart on PackedFloat64Array {
+  Float64List toFloat64List() {
+    final length = size();
+    if (length == 0) return Float64List(0);
+    return Float64List.fromList(gde
+        .packedFloat64ArrayOperatorIndexConst(nativePtr.cast(), 0)
+        .asTypedList(length));
+  }
+}
+
+extension ListToGodot on List<Object?> {
+  /// An Array holding each element converted to a Variant.
+  Array toGodotArray() {
+    final array = Array()..resize(length);
+    for (var i = 0; i < length; ++i) {
+      // Resizing fills the Array with nil Variants
+      writeVariant(gde.arrayOperatorIndex(array.nativePtr.cast(), i), this[i]);
+    }
+    return array;
+  }
+}
+
+extension ArrayToDart on Array {
+  /// The elements converted to Dart, as by [convertFromVariant].
+  List<Object?> toList() {
+    final length = size();
+    return List.generate(
+      length,
+      (i) => convertVariantPtrToDart(
+          gde.arrayOperatorIndexConst(nativePtr.cast(), i), null),
+    );
+  }
+}
+
+extension MapToGodot on Map<Object?, Object?> {
+  /// A Dictionary holding each key and value converted to a Variant.
+  Dictionary toGodotDictionary() {
+    final dictionary = Dictionary();
+    gde.scratch.scope((arena) {
+      final key = VariantList(1, arena);
+      for (final entry in entries) {
+        key[0] = entry.key;
+        final value = gde.dictionaryOperatorIndex(
+            dictionary.nativePtr.cast(), key.elementPtr(0));
+        if (gde.variantGetType(value) !=
+            GDExtensionVariantType.GDEXTENSION_VARIANT_TYPE_NIL) {
+          gde.variantDestroy(value);
+        }
+        writeVariant(value, entry.value);
+      }
+      key.destroy();
+    });
+    return dictionary;
+  }
+}
+
+extension DictionaryToDart on Dictionary {
+  /// The entries with their keys and values converted to Dart.
+  Map<Object?, Object?> toMap() {
+    return Map.fromIterables(keys().toList(), values().toList());
+  }
+}
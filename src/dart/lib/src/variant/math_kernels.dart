@@ -0,0 +1,97 @@
+import 'dart:typed_data';
+
+// SIMD kernels behind the batch APIs of the generated math builtins
+// (Transform3D.xformPoints, AABB.cull). They work on packed single precision
+// buffers, the layout of PackedVector3Array in single precision builds.
+
+/// Transform the points packed as x, y, z in [points] into [out], which may be
+/// the same list. [column0] to [column2] are the columns of the basis and
+/// [origin] the translation, with the fourth lane unused.
+void transformPoints(
+  Float32x4 column0,
+  Float32x4 column1,
+  Float32x4 column2,
+  Float32x4 origin,
+  Float32List points,
+  Float32List out,
+) {
+  assert(points.length % 3 == 0 && out.length >= points.length);
+  for (var i = 0; i < points.length; i += 3) {
+    final result = column0.scale(points[i]) +
+        column1.scale(points[i + 1]) +
+        column2.scale(points[i + 2]) +
+        origin;
+    out[i] = result.x;
+    out[i + 1] = result.y;
+    out[i + 2] = result.z;
+  }
+}
+
+/// Test the boxes packed as position x, y, z, size x, y, z in [aabbs] against
+/// the convex volume bounded by [planes], each holding its normal in x, y, z
+/// and its distance in w. A box is culled if it is entirely above any plane,
+/// as in Godot's AABB.intersects_convex_shape.
+///
+/// Writes 1 to [visible] for the boxes that are kept and 0 for the ones that
+/// are culled, and returns the number kept. Four boxes are tested at a time.
+int cullAabbs(Float32List aabbs, List<Float32x4> planes, Uint8List visible) {
+  final count = aabbs.length ~/ 6;
+  assert(aabbs.length % 6 == 0 && visible.length >= count);
+
+  // Per plane lanes, splatted once: normal, |normal| and distance
+  final planeLanes = <Float32x4>[];
+  for (final plane in planes) {
+    final normalAbs = plane.abs();
+    planeLanes
+      ..add(Float32x4.splat(plane.x))
+      ..add(Float32x4.splat(plane.y))
+      ..add(Float32x4.splat(plane.z))
+      ..add(Float32x4.splat(normalAbs.x))
+      ..add(Float32x4.splat(normalAbs.y))
+      ..add(Float32x4.splat(normalAbs.z))
+      ..add(Float32x4.splat(plane.w));
+  }
+
+  final half = Float32x4.splat(0.5);
+  final soa = Float32x4List(6);
+  final lanes = soa.buffer.asFloat32List();
+  var kept = 0;
+  for (var box = 0; box < count; box += 4) {
+    // Gather up to four boxes into structure of arrays form, padding the
+    // last group with empty boxes
+    for (var lane = 0; lane < 4; ++lane) {
+      final src = (box + lane) * 6;
+      for (var component = 0; component < 6; ++component) {
+        lanes[component * 4 + lane] =
+            box + lane < count ? aabbs[src + component] : 0.0;
+      }
+    }
+    final extentX = (soa[3] * half).abs();
+    final extentY = (soa[4] * half).abs();
+    final extentZ = (soa[5] * half).abs();
+    final centerX = soa[0] + soa[3] * half;
+    final centerY = soa[1] + soa[4] * half;
+    final centerZ = soa[2] + soa[5] * half;
+
+    var culled = Int32x4(0, 0, 0, 0);
+    for (var p = 0; p < planeLanes.length; p += 7) {
+      final distance = centerX * planeLanes[p] +
+          centerY * planeLanes[p + 1] +
+          centerZ * planeLanes[p + 2] -
+          planeLanes[p + 6];
+      final radius = extentX * planeLanes[p + 3] +
+          extentY * planeLanes[p + 4] +
+          extentZ * planeLanes[p + 5];
+      culled = culled | distance.greaterThan(radius);
+    }
+
+    final culledMask = culled.signMask;
+    for (var lane = 0; lane < 4 && box + lane < count; ++lane) {
+      final isVisible = (culledMask >> lane) & 1 == 0;
+      visible[box + lane] = isVisible ? 1 : 0;
+      if (isVisible) kept++;
+    }
+  }
+
+  return kept;
+}
@@ -0,0 +1,180 @@
+import 'dart:ffi';
+import 'dart:typed_data';
+
+import '../../godot_dart.dart';
+
+// Typed data views directly over the storage of Godot's packed arrays, for
+// processing mesh, heightmap or audio data in Dart without copying it.
+//
+// Packed arrays share their storage copy-on-write. asTypedList makes the
+// storage unique to the array it's called on, like any write through Godot
+// would, so writes through the view only change that array. A view is only
+// valid until the storage changes hands:
+//
+//  * resizing, appending to or otherwise reallocating the array, including
+//    from Godot, leaves the view pointing at freed memory
+//  * copying the array, or passing it to Godot which may keep a copy, shares
+//    the storage again, so later writes through the view show up in the copy
+//    too
+//
+// A view keeps the array object it came from reachable, so the array's
+// finalizer can't free the storage while the view is in use, even for
+// temporaries like `mesh.getVertices().asTypedList()`. This doesn't protect
+// against the rules above, which apply to the storage, not the object.
+//
+// Get a view, use it and drop it. For data that outlives that, copy it out
+// with the conversions in collections.dart instead. asReadOnlyTypedList
+// doesn't make the storage unique, so it's cheaper for reading and shares
+// the same invalidation rules.
+
+// Holds each array strongly for as long as a view of it is reachable
+final Finalizer<BuiltinType> _viewOwners = Finalizer((_) {});
+
+T _ownedBy<T extends TypedData>(T view, BuiltinType array) {
+  _viewOwners.attach(view, array);
+  return view;
+}
+
+extension PackedByteArrayView on PackedByteArray {
+  Uint8List asTypedList() {
+    final length = size();
+    if (length == 0) return Uint8List(0);
+    final view = gde
+        .packedByteArrayOperatorIndex(nativePtr.cast(), 0)
+        .asTypedList(length);
+    return _ownedBy(view, this);
+  }
+
+  Uint8List asReadOnlyTypedList() {
+    final length = size();
+    if (length == 0) return Uint8List(0);
+    final view = gde
+        .packedByteArrayOperatorIndexConst(nativePtr.cast(), 0)
+        .asTypedList(length);
+    return _ownedBy(UnmodifiableUint8ListView(view), this);
+  }
+}
+
+extension PackedInt32ArrayView on PackedInt32Array {
+  Int32List asTypedList() {
+    final length = size();
+    if (length == 0) return Int32List(0);
+    final view = gde
+        .packedInt32ArrayOperatorIndex(nativePtr.cast(), 0)
+        .asTypedList(length);
+    return _ownedBy(view, this);
+  }
+
+  Int32List asReadOnlyTypedList() {
+    final length = size();
+    if (length == 0) return Int32List(0);
+    final view = gde
+        .packedInt32ArrayOperatorIndexConst(nativePtr.cast(), 0)
+        .asTypedList(length);
+    return _ownedBy(UnmodifiableInt32ListView(view), this);
+  }
+}
+
+extension PackedInt64ArrayView on PackedInt64Array {
+  Int64List asTypedList() {
+    final length = size();
+    if (length == 0) return Int64List(0);
+    final view = gde
+        .packedInt64ArrayOperatorIndex(nativePtr.cast(), 0)
+        .asTypedList(length);
+    return _ownedBy(view, this);
+  }
+
+  Int64List asReadOnlyTypedList() {
+    final length = size();
+    if (length == 0) return Int64List(0);
+    final view = gde
+        .packedInt64ArrayOperatorIndexConst(nativePtr.cast(), 0)
+        .asTypedList(length);
+    return _ownedBy(UnmodifiableInt64ListView(view), this);
+  }
+}
+
+extension PackedFloat32ArrayView on PackedFloat32Array {
+  Float32List asTypedList() {
+    final length = size();
+    if (length == 0) return Float32List(0);
+    final view = gde
+        .packedFloat32ArrayOperatorIndex(nativePtr.cast(), 0)
+        .asTypedList(length);
+    return _ownedBy(view, this);
+  }
+
+  Float32List asReadOnlyTypedList() {
+    final length = size();
+    if (length == 0) return Float32List(0);
+    final view = gde
+        .packedFloat32ArrayOperatorIndexConst(nativePtr.cast(), 0)
+        .asTypedList(length);
+    return _ownedBy(UnmodifiableFloat32ListView(view), this);
+  }
+}
+
+extension PackedFloat64ArrayView on PackedFloat64Array {
+  Float64List asTypedList() {
+    final length = size();
+    if (length == 0) return Float64List(0);
+    final view = gde
+        .packedFloat64ArrayOperatorIndex(nativePtr.cast(), 0)
+        .asTypedList(length);
+    return _ownedBy(view, this);
+  }
+
+  Float64List asReadOnlyTypedList() {
+    final length = size();
+    if (length == 0) return Float64List(0);
+    final view = gde
+        .packedFloat64ArrayOperatorIndexConst(nativePtr.cast(), 0)
+        .asTypedList(length);
+    return _ownedBy(UnmodifiableFloat64ListView(view), this);
+  }
+}
+
+// The vector arrays are viewed as their components: x, y for Vector2, x, y, z
+// for Vector3 and r, g, b, a for Color. Vector components are real_t, so these
+// views are only available in single precision builds.
+
+extension PackedVector2ArrayView on PackedVector2Array {
+  Float32List asTypedList() {
+    assert(Vector2.typeInfo.size == 8, 'Vector2 is not single precision');
+    final length = size() * 2;
+    if (length == 0) return Float32List(0);
+    final view = gde
+        .packedVector2ArrayOperatorIndex(nativePtr.cast(), 0)
+        .cast<Float>()
+        .asTypedList(length);
+    return _ownedBy(view, this);
+  }
+}
+
+extension PackedVector3ArrayView on PackedVector3Array {
+  /// The points as x, y, z, which can be passed to Transform3D.xformPoints
+  /// to transform them in place.
+  Float32List asTypedList() {
+    assert(Vector3.typeInfo.size == 12, 'Vector3 is not single precision');
+    final length = size() * 3;
+    if (length == 0) return Float32List(0);
+    final view = gde
+        .packedVector3ArrayOperatorIndex(nativePtr.cast(), 0)
+        .cast<Float>()
+        .asTypedList(length);
+    return _ownedBy(view, this);
+  }
+}
+
+extension PackedColorArrayView on PackedColorArray {
+  Float32List asTypedList() {
+    final length = size() * 4;
+    if (length == 0) return Float32List(0);
+    final view = gde
+        .packedColorArrayOperatorIndex(nativePtr.cast(), 0)
+        .cast<Float>()
+        .asTypedList(length);
+    return _ownedBy(view, this);
+  }
+}
@@ -1,4 +1,5 @@
 import 'dart:ffi';
+import 'dart:typed_data';
 
 import 'package:ffi/ffi.dart';
 
@@ -7,13 +8,35 @@ import '../core/gdextension_ffi_bindings.dart';
 
 typedef GDExtensionVariantFromType = void Function(
     GDExtensionVariantPtr, GDExtensionTypePtr);
+typedef GDExtensionVariantToType = void Function(
+    GDExtensionTypePtr, GDExtensionVariantPtr);
 
 late List<GDExtensionVariantFromType?> _fromTypeConstructor;
-late List<GDExtensionTypeFromVariantConstructorFunc?> _toTypeConstructor;
+late List<GDExtensionVariantToType?> _toTypeConstructor;
 
+// Builtins registered by initVariantBindings, which builds the converters
+// from them. Nothing looks these up per conversion.
 typedef BuiltinConstructor = BuiltinType Function();
 Map<int, BuiltinConstructor> _dartBuiltinConstructors = {};
 
+// Builtins that are plain data, like the math types, are converted from a
+// Variant into scratch memory and copied out by their fromPointer constructor
+typedef BuiltinFromPointer = BuiltinType Function(Pointer<Void>);
+
+class _PlainBuiltin {
+  final int size;
+  final BuiltinFromPointer fromPointer;
+
+  _PlainBuiltin(this.size, this.fromPointer);
+}
+
+Map<int, _PlainBuiltin> _dartPlainBuiltins = {};
+
+void _registerPlainBuiltin(TypeInfo typeInfo, BuiltinFromPointer fromPointer) {
+  _dartPlainBuiltins[typeInfo.variantType] =
+      _PlainBuiltin(typeInfo.size, fromPointer);
+}
+
 void initVariantBindings(GDExtensionInterface gdeInterface) {
   _fromTypeConstructor = List.generate(
     GDExtensionVariantType.GDEXTENSION_VARIANT_TYPE_VARIANT_MAX,
@@ -24,7 +47,12 @@ void initVariantBindings(GDExtensionInterface gdeInterface) {
       GDExtensionVariantFromTypeConstructorFunc Function(int) f;
       f = gdeInterface.get_variant_from_type_constructor
           .asFunction(isLeaf: true);
-      return f(variantType).asFunction(isLeaf: true);
+      // Constructing a Variant from an Object or a container references the
+      // Objects in it
+      final constructor = f(variantType);
+      return variantTypeHoldsObjects(variantType)
+          ? constructor.asFunction()
+          : constructor.asFunction(isLeaf: true);
     },
   );
   _toTypeConstructor = List.generate(
@@ -35,7 +63,10 @@ void initVariantBindings(GDExtensionInterface gdeInterface) {
       }
       GDExtensionTypeFromVariantConstructorFunc Function(int) f;
       f = gdeInterface.get_variant_to_type_constructor.asFunction(isLeaf: true);
-      return f(variantType);
+      final constructor = f(variantType);
+      return variantTypeHoldsObjects(variantType)
+          ? constructor.asFunction()
+          : constructor.asFunction(isLeaf: true);
     },
   );
 
@@ -50,37 +81,37 @@ void initVariantBindings(GDExtensionInterface gdeInterface) {
 
   // Generate this?
   Vector2.initBindings();
-  _dartBuiltinConstructors[Vector2.typeInfo.variantType] = Vector2.new;
+  _registerPlainBuiltin(Vector2.typeInfo, Vector2.fromPointer);
   Vector2i.initBindings();
-  _dartBuiltinConstructors[Vector2i.typeInfo.variantType] = Vector2i.new;
+  _registerPlainBuiltin(Vector2i.typeInfo, Vector2i.fromPointer);
   Vector3.initBindings();
-  _dartBuiltinConstructors[Vector3.typeInfo.variantType] = Vector3.new;
+  _registerPlainBuiltin(Vector3.typeInfo, Vector3.fromPointer);
   Vector3i.initBindings();
-  _dartBuiltinConstructors[Vector3i.typeInfo.variantType] = Vector3i.new;
+  _registerPlainBuiltin(Vector3i.typeInfo, Vector3i.fromPointer);
   Vector4.initBindings();
-  _dartBuiltinConstructors[Vector4.typeInfo.variantType] = Vector4.new;
+  _registerPlainBuiltin(Vector4.typeInfo, Vector4.fromPointer);
   Vector4i.initBindings();
-  _dartBuiltinConstructors[Vector4i.typeInfo.variantType] = Vector4i.new;
+  _registerPlainBuiltin(Vector4i.typeInfo, Vector4i.fromPointer);
   Quaternion.initBindings();
-  _dartBuiltinConstructors[Quaternion.typeInfo.variantType] = Quaternion.new;
+  _registerPlainBuiltin(Quaternion.typeInfo, Quaternion.fromPointer);
   Rect2.initBindings();
-  _dartBuiltinConstructors[Rect2.typeInfo.variantType] = Rect2.new;
+  _registerPlainBuiltin(Rect2.typeInfo, Rect2.fromPointer);
   Rect2i.initBindings();
-  _dartBuiltinConstructors[Rect2i.typeInfo.variantType] = Rect2i.new;
+  _registerPlainBuiltin(Rect2i.typeInfo, Rect2i.fromPointer);
   Transform2D.initBindings();
-  _dartBuiltinConstructors[Transform2D.typeInfo.variantType] = Transform2D.new;
+  _registerPlainBuiltin(Transform2D.typeInfo, Transform2D.fromPointer);
   Plane.initBindings();
-  _dartBuiltinConstructors[Plane.typeInfo.variantType] = Plane.new;
+  _registerPlainBuiltin(Plane.typeInfo, Plane.fromPointer);
   AABB.initBindings();
-  _dartBuiltinConstructors[AABB.typeInfo.variantType] = AABB.new;
+  _registerPlainBuiltin(AABB.typeInfo, AABB.fromPointer);
   Basis.initBindings();
-  _dartBuiltinConstructors[Basis.typeInfo.variantType] = Basis.new;
+  _registerPlainBuiltin(Basis.typeInfo, Basis.fromPointer);
   Transform3D.initBindings();
-  _dartBuiltinConstructors[Transform3D.typeInfo.variantType] = Transform3D.new;
+  _registerPlainBuiltin(Transform3D.typeInfo, Transform3D.fromPointer);
   Projection.initBindings();
-  _dartBuiltinConstructors[Projection.typeInfo.variantType] = Projection.new;
+  _registerPlainBuiltin(Projection.typeInfo, Projection.fromPointer);
   Color.initBindings();
-  _dartBuiltinConstructors[Color.typeInfo.variantType] = Color.new;
+  _registerPlainBuiltin(Color.typeInfo, Color.fromPointer);
   NodePath.initBindings();
   _dartBuiltinConstructors[NodePath.typeInfo.variantType] = NodePath.new;
   RID.initBindings();
@@ -120,12 +151,41 @@ void initVariantBindings(GDExtensionInterface gdeInterface) {
   PackedColorArray.initBindings();
   _dartBuiltinConstructors[PackedColorArray.typeInfo.variantType] =
       PackedColorArray.new;
+
+  _initConverters();
+}
+
+// Storage for Variants created from Dart. Variants are carved out of slabs
+// and recycled through a free list, so creating one is usually a list pop
+// rather than a malloc. Slabs are never returned, the pool stays at its peak.
+class _VariantPool {
+  static const int _slabLength = 64;
+
+  final _free = <Pointer<Uint8>>[];
+
+  Pointer<Uint8> take() {
+    if (_free.isEmpty) {
+      final slab = malloc<Uint8>(_slabLength * Variant._size);
+      for (var i = _slabLength - 1; i >= 0; --i) {
+        _free.add(slab.elementAt(i * Variant._size));
+      }
+    }
+    final variant = _free.removeLast();
+    gde.variantNewNil(variant.cast());
+    return variant;
+  }
+
+  void release(Pointer<Uint8> variant) {
+    gde.variantDestroy(variant.cast());
+    _free.add(variant);
+  }
 }
 
 // TODO: Variant probably shouldn't extend BuiltinType?
 class Variant extends BuiltinType {
+  static final _pool = _VariantPool();
   static final Finalizer<Pointer<Uint8>> _finalizer =
-      Finalizer((mem) => calloc.free(mem));
+      Finalizer((mem) => _pool.release(mem));
 
   // TODO: This is supposed to come from the generator, but we
   // may just need to take the max size
@@ -135,164 +195,320 @@ class Variant extends BuiltinType {
   @override
   TypeInfo get staticTypeInfo => typeInfo;
 
+  @pragma('vm:entry-point', 'get')
   final Pointer<Uint8> _opaque;
   @override
   Pointer<Uint8> get nativePtr => _opaque;
 
-  Variant() : _opaque = calloc<Uint8>(_size) {
+  /// A nil Variant owned by this object. Its value is destroyed and its
+  /// storage returned to the pool when the object is collected.
+  Variant()
+      : _opaque = _pool.take(),
+        super.unowned() {
     _finalizer.attach(this, _opaque);
   }
 
   // Godot manages this pointer, don't free it
-  Variant.fromPointer(Pointer<void> ptr) : _opaque = ptr.cast();
+  Variant.fromPointer(Pointer<void> ptr)
+      : _opaque = ptr.cast(),
+        super.unowned();
 
   int getType() {
-    int Function(Pointer<Void>) getType =
-        gde.interface.ref.variant_get_type.asFunction();
-    return getType(_opaque.cast());
+    return gde.variantGetType(_opaque.cast());
   }
 
   static void initBindings() {
     typeInfo = TypeInfo(
-      StringName.fromString('Variant'),
+      StringName.interned('Variant'),
       variantType: GDExtensionVariantType.GDEXTENSION_VARIANT_TYPE_VARIANT_MAX,
       size: _size,
     );
   }
 }
 
+/// [length] contiguous Variants in memory from an [Allocator], such as the
+/// argument pack of a call, which costs one allocation however many arguments
+/// there are.
+///
+/// The elements start out nil. Call [destroy] before the memory is released
+/// to release the values they hold.
+class VariantList {
+  final int length;
+  final Pointer<Uint8> _data;
+
+  VariantList(this.length, Allocator allocator)
+      : _data = allocator.allocate<Uint8>(length * Variant._size) {
+    for (var i = 0; i < length; ++i) {
+      gde.variantNewNil(elementPtr(i));
+    }
+  }
+
+  GDExtensionVariantPtr elementPtr(int index) {
+    RangeError.checkValidIndex(index, this);
+    return _data.elementAt(index * Variant._size).cast();
+  }
+
+  /// Replace element [index] with [value] converted to a Variant.
+  void operator []=(int index, Object? value) {
+    final ptr = elementPtr(index);
+    if (gde.variantGetType(ptr) !=
+        GDExtensionVariantType.GDEXTENSION_VARIANT_TYPE_NIL) {
+      gde.variantDestroy(ptr);
+    }
+    writeVariant(ptr, value);
+  }
+
+  /// Element [index] converted to Dart.
+  Object? toDart(int index,
+      [Pointer<GDExtensionInstanceBindingCallbacks>? bindingCallbacks]) {
+    return convertVariantPtrToDart(elementPtr(index), bindingCallbacks);
+  }
+
+  void destroy() {
+    for (var i = 0; i < length; ++i) {
+      gde.variantDestroy(elementPtr(i));
+    }
+  }
+}
+
 Variant convertToVariant(Object? obj) {
   final ret = Variant();
-  final objectType = obj?.runtimeType;
-  void Function(GDExtensionVariantPtr, GDExtensionTypePtr)? c;
+  writeVariant(ret.nativePtr.cast(), obj);
+  return ret;
+}
 
-  // First easy checks, are we null?
+/// Construct a Variant holding [obj] in [dest], which must not hold a value.
+void writeVariant(GDExtensionVariantPtr dest, Object? obj) {
+  // Checked roughly by how common they are as arguments. Primitives go
+  // through a single reused slot, the from-type constructors copy out of it
+  // before returning.
   if (obj == null) {
-    GodotDart.instance!.interface.ref.variant_new_nil
-        .asFunction<void Function(GDExtensionVariantPtr)>(
-            isLeaf: true)(ret.nativePtr.cast());
+    gde.variantNewNil(dest);
   } else if (obj is ExtensionType) {
-    // Already an Object, but constructor expects a pointer to the object
-    Pointer<GDExtensionVariantPtr> ptrToObj = malloc<GDExtensionVariantPtr>();
-    ptrToObj.value = obj.nativePtr;
-    c = _fromTypeConstructor[
-        GDExtensionVariantType.GDEXTENSION_VARIANT_TYPE_OBJECT];
-    c?.call(ret.nativePtr.cast(), ptrToObj.cast());
-    malloc.free(ptrToObj);
+    // Already an Object, but constructor expects a pointer to the object.
+    // This isn't a leaf call and can run Dart, so it doesn't share _slot.
+    gde.scratch.scope((arena) {
+      final objectPtr = arena<GDExtensionObjectPtr>();
+      objectPtr.value = obj.nativePtr;
+      _fromObject(dest, objectPtr.cast());
+    });
+  } else if (obj is int) {
+    _slot.value = obj;
+    _fromInt(dest, _slot.cast());
+  } else if (obj is double) {
+    _slot.cast<Double>().value = obj;
+    _fromFloat(dest, _slot.cast());
+  } else if (obj is bool) {
+    _slot.cast<GDExtensionBool>().value = obj ? 1 : 0;
+    _fromBool(dest, _slot.cast());
+  } else if (obj is String) {
+    _fromString(dest, GDString.cached(obj).nativePtr.cast());
+  } else if (obj is Variant) {
+    gde.variantNewCopy(dest, obj.nativePtr.cast());
   } else if (obj is BuiltinType) {
-    // Builtin type
-    var typeInfo = obj.staticTypeInfo;
-    c = _fromTypeConstructor[typeInfo.variantType];
-    c?.call(ret.nativePtr.cast(), obj.nativePtr.cast());
+    final c = _fromTypeConstructor[obj.staticTypeInfo.variantType];
+    if (c == null) {
+      gde.variantNewNil(dest);
+      return;
+    }
+    if (obj is BuiltinValueType) {
+      gde.scratch.scope((arena) {
+        final ptr = arena.allocate<Uint8>(obj.staticTypeInfo.size);
+        obj.copyToNative(ptr.cast());
+        c(dest, ptr.cast());
+      });
+    } else {
+      c(dest, obj.nativePtr.cast());
+    }
+  } else if (obj is TypedData) {
+    _writeTypedData(dest, obj);
+  } else if (obj is List<Object?>) {
+    _writeTemporary(dest, obj.toGodotArray());
+  } else if (obj is Map<Object?, Object?>) {
+    _writeTemporary(dest, obj.toGodotDictionary());
   } else {
-    // Convert built in types
-    using((arena) {
-      switch (objectType) {
-        case bool:
-          final b = arena.allocate<GDExtensionBool>(sizeOf<GDExtensionBool>());
-          b.value = (obj as bool) ? 1 : 0;
-          c = _fromTypeConstructor[
-              GDExtensionVariantType.GDEXTENSION_VARIANT_TYPE_BOOL];
-          c?.call(ret.nativePtr.cast(), b.cast());
-          break;
-        case int:
-          final i = arena.allocate<GDExtensionInt>(sizeOf<GDExtensionInt>());
-          i.value = obj as int;
-          c = _fromTypeConstructor[
-              GDExtensionVariantType.GDEXTENSION_VARIANT_TYPE_INT];
-          c?.call(ret.nativePtr.cast(), i.cast());
-          break;
-        case double:
-          final d = arena.allocate<Double>(sizeOf<Double>());
-          d.value = obj as double;
-          c = _fromTypeConstructor[
-              GDExtensionVariantType.GDEXTENSION_VARIANT_TYPE_FLOAT];
-          c?.call(ret.nativePtr.cast(), d.cast());
-          break;
-        case String:
-          final gdString = GDString.fromString(obj as String);
-          c = _fromTypeConstructor[
-              GDExtensionVariantType.GDEXTENSION_VARIANT_TYPE_STRING];
-          c?.call(ret.nativePtr.cast(), gdString.nativePtr.cast());
-          break;
-        // TODO: All the other variant types (dictionary? List?)
-        default:
-          // If we got here, return nil variant
-          GodotDart.instance!.interface.ref.variant_new_nil
-              .asFunction<void Function(GDExtensionVariantPtr)>(
-                  isLeaf: true)(ret.nativePtr.cast());
-      }
-    });
+    // TODO: Closures, which need custom Callables that GDExtension 4.0 can't
+    // create
+    gde.variantNewNil(dest);
   }
+}
 
-  return ret;
+void _writeTypedData(GDExtensionVariantPtr dest, TypedData data) {
+  if (data is Uint8List) {
+    _writeTemporary(dest, data.toPackedArray());
+  } else if (data is Int32List) {
+    _writeTemporary(dest, data.toPackedArray());
+  } else if (data is Int64List) {
+    _writeTemporary(dest, data.toPackedArray());
+  } else if (data is Float32List) {
+    _writeTemporary(dest, data.toPackedArray());
+  } else if (data is Float64List) {
+    _writeTemporary(dest, data.toPackedArray());
+  } else if (data is List<Object?>) {
+    // Other element types don't have a packed array
+    _writeTemporary(dest, (data as List<Object?>).toGodotArray());
+  } else {
+    gde.variantNewNil(dest);
+  }
+}
+
+// Write [value], a builtin made just for the conversion, to [dest]. The
+// Variant takes its own reference, so the temporary's is released. It is
+// destroyed here, so a frame scope must not destroy it again.
+void _writeTemporary(GDExtensionVariantPtr dest, BuiltinType value) {
+  final variantType = value.staticTypeInfo.variantType;
+  _fromTypeConstructor[variantType]!(dest, value.nativePtr.cast());
+  GodotArena.release(value.nativePtr);
+  _destructors[variantType]!(value.nativePtr.cast());
 }
 
 Object? convertFromVariant(
   Variant variant,
   Pointer<GDExtensionInstanceBindingCallbacks>? bindingCallbacks,
 ) {
-  Object? ret;
-  int variantType = variant.getType();
-  void Function(GDExtensionTypePtr, GDExtensionVariantPtr)? c;
-  if (variantType > 0 && variantType < _toTypeConstructor.length) {
-    c = _toTypeConstructor[variantType]?.asFunction();
-  }
+  return convertVariantPtrToDart(variant.nativePtr.cast(), bindingCallbacks);
+}
+
+/// Convert the Variant at [variant] to Dart, without wrapping it in a
+/// [Variant] object.
+Object? convertVariantPtrToDart(
+  GDExtensionConstVariantPtr variant,
+  Pointer<GDExtensionInstanceBindingCallbacks>? bindingCallbacks,
+) {
+  final converter = _toDart[gde.variantGetType(variant)];
+  // TODO: Output an error message for types without a converter
+  return converter?.call(variant, bindingCallbacks);
+}
+
+// Converters from a Variant to Dart, indexed by variant type and built once
+// by initVariantBindings.
+typedef _ToDartConverter = Object? Function(GDExtensionConstVariantPtr,
+    Pointer<GDExtensionInstanceBindingCallbacks>?);
+
+late List<_ToDartConverter?> _toDart;
+
+// Scratch slot for primitives on their way to or from a Variant. Conversions
+// through it are leaf calls, so it's never used twice at once. Objects can't
+// use it, their conversions aren't leaf calls (see variantTypeHoldsObjects).
+final Pointer<Int64> _slot = malloc<Int64>();
 
+late GDExtensionVariantFromType _fromObject;
+late GDExtensionVariantFromType _fromInt;
+late GDExtensionVariantFromType _fromFloat;
+late GDExtensionVariantFromType _fromBool;
+late GDExtensionVariantFromType _fromString;
+late void Function(GDExtensionTypePtr) _destroyString;
+
+// Destructors of the types _writeTemporary converts, indexed by variant type
+late List<void Function(GDExtensionTypePtr)?> _destructors;
+
+void _initConverters() {
+  GDExtensionVariantFromType from(int variantType) =>
+      _fromTypeConstructor[variantType]!;
+  _fromObject = from(GDExtensionVariantType.GDEXTENSION_VARIANT_TYPE_OBJECT);
+  _fromInt = from(GDExtensionVariantType.GDEXTENSION_VARIANT_TYPE_INT);
+  _fromFloat = from(GDExtensionVariantType.GDEXTENSION_VARIANT_TYPE_FLOAT);
+  _fromBool = from(GDExtensionVariantType.GDEXTENSION_VARIANT_TYPE_BOOL);
+  _fromString = from(GDExtensionVariantType.GDEXTENSION_VARIANT_TYPE_STRING);
+  _destroyString = gde
+      .variantGetDestructor(
+          GDExtensionVariantType.GDEXTENSION_VARIANT_TYPE_STRING)
+      .asFunction(isLeaf: true);
+
+  const temporaryTypes = {
+    GDExtensionVariantType.GDEXTENSION_VARIANT_TYPE_ARRAY,
+    GDExtensionVariantType.GDEXTENSION_VARIANT_TYPE_DICTIONARY,
+    GDExtensionVariantType.GDEXTENSION_VARIANT_TYPE_PACKED_BYTE_ARRAY,
+    GDExtensionVariantType.GDEXTENSION_VARIANT_TYPE_PACKED_INT32_ARRAY,
+    GDExtensionVariantType.GDEXTENSION_VARIANT_TYPE_PACKED_INT64_ARRAY,
+    GDExtensionVariantType.GDEXTENSION_VARIANT_TYPE_PACKED_FLOAT32_ARRAY,
+    GDExtensionVariantType.GDEXTENSION_VARIANT_TYPE_PACKED_FLOAT64_ARRAY,
+  };
+  _destructors = List.generate(
+    GDExtensionVariantType.GDEXTENSION_VARIANT_TYPE_VARIANT_MAX,
+    (variantType) {
+      if (!temporaryTypes.contains(variantType)) return null;
+      // Destroying a container can release the last reference to an Object
+      // in it, which calls back into the bindings
+      final destructor = gde.variantGetDestructor(variantType);
+      return variantTypeHoldsObjects(variantType)
+          ? destructor.asFunction()
+          : destructor.asFunction(isLeaf: true);
+    },
+  );
+
+  _toDart = List.generate(
+    GDExtensionVariantType.GDEXTENSION_VARIANT_TYPE_VARIANT_MAX,
+    _makeToDart,
+  );
+}
+
+_ToDartConverter? _makeToDart(int variantType) {
+  final c = _toTypeConstructor[variantType];
   if (c == null) {
-    // TODO: Output an error message
     return null;
   }
 
-  // To we have a CoreType that we can use to match?
+  switch (variantType) {
+    case GDExtensionVariantType.GDEXTENSION_VARIANT_TYPE_BOOL:
+      return (variant, _) {
+        c(_slot.cast(), variant);
+        return _slot.cast<GDExtensionBool>().value != 0;
+      };
+    case GDExtensionVariantType.GDEXTENSION_VARIANT_TYPE_INT:
+      return (variant, _) {
+        c(_slot.cast(), variant);
+        return _slot.value;
+      };
+    case GDExtensionVariantType.GDEXTENSION_VARIANT_TYPE_FLOAT:
+      return (variant, _) {
+        c(_slot.cast(), variant);
+        return _slot.cast<Double>().value;
+      };
+    case GDExtensionVariantType.GDEXTENSION_VARIANT_TYPE_STRING:
+      // Converted into an empty String in scratch memory, which is destroyed
+      // once it's been read
+      return (variant, _) {
+        return gde.scratch.scope((arena) {
+          final string = arena.allocate<Uint8>(GDString.typeInfo.size);
+          c(string.cast(), variant);
+          final result =
+              gde.dartBindings.gdStringToString(GDString.unowned(string));
+          _destroyString(string.cast());
+          return result;
+        });
+      };
+    case GDExtensionVariantType.GDEXTENSION_VARIANT_TYPE_OBJECT:
+      return (variant, bindingCallbacks) {
+        final object = gde.scratch.scope((arena) {
+          final objectPtr = arena<GDExtensionObjectPtr>();
+          c(objectPtr.cast(), variant);
+          return objectPtr.value;
+        });
+        return gde.dartBindings.gdObjectToDartObject(object, bindingCallbacks);
+      };
+  }
+
+  final plainBuiltin = _dartPlainBuiltins[variantType];
+  if (plainBuiltin != null) {
+    return (variant, _) {
+      return gde.scratch.scope((arena) {
+        final ptr = arena.allocate<Uint8>(plainBuiltin.size);
+        c(ptr.cast(), variant);
+        return plainBuiltin.fromPointer(ptr.cast());
+      });
+    };
+  }
+
   final builtinConstructor = _dartBuiltinConstructors[variantType];
   if (builtinConstructor != null) {
-    var builtin = builtinConstructor();
-    c(builtin.nativePtr.cast(), variant.nativePtr.cast());
-    return builtin;
+    return (variant, _) {
+      final builtin = builtinConstructor();
+      c(builtin.nativePtr.cast(), variant);
+      return builtin;
+    };
   }
 
-  // Else, it's probably a dart native type
-  using((arena) {
-    switch (variantType) {
-      // Built-in types
-      case GDExtensionVariantType.GDEXTENSION_VARIANT_TYPE_BOOL:
-        Pointer<GDExtensionBool> ptr =
-            arena.allocate(sizeOf<GDExtensionBool>());
-        c!(ptr.cast(), variant.nativePtr.cast());
-        ret = ptr.value != 0;
-        break;
-      case GDExtensionVariantType.GDEXTENSION_VARIANT_TYPE_INT:
-        Pointer<GDExtensionInt> ptr = arena.allocate(sizeOf<GDExtensionInt>());
-        c!(ptr.cast(), variant.nativePtr.cast());
-        ret = ptr.value;
-        break;
-      case GDExtensionVariantType.GDEXTENSION_VARIANT_TYPE_FLOAT:
-        Pointer<Double> ptr = arena.allocate(sizeOf<Double>());
-        c!(ptr.cast(), variant.nativePtr.cast());
-        ret = ptr.value;
-        break;
-      case GDExtensionVariantType.GDEXTENSION_VARIANT_TYPE_STRING:
-        var gdString = GDString();
-        c!(gdString.nativePtr.cast(), variant.nativePtr.cast());
-        ret = gde.dartBindings.gdStringToString(gdString);
-        break;
-
-      // Or a wrapped object
-      case GDExtensionVariantType.GDEXTENSION_VARIANT_TYPE_OBJECT:
-        Pointer<GDExtensionObjectPtr> ptr =
-            arena.allocate(sizeOf<GDExtensionObjectPtr>());
-        c!(ptr.cast(), variant.nativePtr.cast());
-        ret = gde.dartBindings.gdObjectToDartObject(
-          ptr.value,
-          bindingCallbacks,
-        );
-        break;
-
-      // TODO: all the other variant types
-      default:
-        ret = null;
-    }
-  });
-  return ret;
+  // TODO: all the other variant types
+  return null;
 }
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <stdint.h>
+
 typedef struct _Dart_Isolate* Dart_Isolate;
 typedef struct _Dart_Handle* Dart_Handle;
 
@@ -21,6 +23,36 @@ DART_DLL_EXPORT bool DartDll_Initialize();
 DART_DLL_EXPORT Dart_Isolate DartDll_LoadScript(const char* script_uri,
                                         const char* package_config);
 
+// Entry points that create the isolate group straight from a precompiled
+// form of the script instead of compiling it. The prebuilt win64 library
+// doesn't export these, GodotDart only calls them when built with
+// GODOT_DART_SNAPSHOT_LOADING against a dart_dll that does.
+
+// Load a script from a kernel buffer, such as a file written by
+// `dart compile kernel`, with Dart_CreateIsolateGroupFromKernel. The buffer
+// must stay valid until the isolate shuts down.
+DART_DLL_EXPORT Dart_Isolate DartDll_LoadKernel(const char* script_uri,
+                                        const char* package_config,
+                                        const uint8_t* kernel_buffer,
+                                        intptr_t kernel_buffer_size);
+
+// Load a script from an AppJIT snapshot in the standalone VM's app snapshot
+// layout, such as one from `dart --snapshot-kind=app-jit`. The file is read
+// and its instructions mapped as executable the way the standalone VM does,
+// and the isolate group is created from its isolate data and instructions
+// with Dart_CreateIsolateGroup. Fails if the snapshot is from a different
+// build of the VM.
+DART_DLL_EXPORT Dart_Isolate DartDll_LoadAppJitSnapshot(
+    const char* snapshot_path, const char* script_uri,
+    const char* package_config);
+
+// Load a script from an ELF snapshot written by `dart compile aot-snapshot`,
+// mapping it with Dart_LoadELF and creating the isolate group from its
+// isolate data and instructions with Dart_CreateIsolateGroup. Only in
+// precompiled runtime builds of dart_dll, which GodotDart uses when built
+// with GODOT_DART_PRECOMPILED_RUNTIME.
+DART_DLL_EXPORT Dart_Isolate DartDll_LoadAotSnapshot(const char* snapshot_path);
+
 // Run "main" from the supplied library, usually one you got from
 // Dart_RootLibrary()
 DART_DLL_EXPORT Dart_Handle DartDll_RunMain(Dart_Handle library);
@@ -0,0 +1,135 @@
+// ignore_for_file: implementation_imports
+
+import 'dart:ffi';
+import 'dart:math';
+import 'dart:typed_data';
+
+import 'package:godot_dart/src/variant/math_kernels.dart';
+import 'package:godot_dart_benchmarks/benchmarks.dart';
+
+// Compares the SIMD batch kernels behind Transform3D.xformPoints and AABB.cull
+// with scalar Dart loops, and with the path they replaced: one FFI call into
+// Godot per value. That path is modelled as the scalar loop plus a leaf call
+// to a native no-op, so it only counts the cost of the calls themselves.
+
+const _count = 10000;
+const _iterations = 2000;
+
+final _noop = nativeFree.asFunction<void Function(Pointer<Void>)>(isLeaf: true);
+
+// [transform] holds the columns of the basis followed by the origin, three
+// floats each
+void _transformPointsScalar(
+    Float32List transform, Float32List points, Float32List out,
+    {bool callPerPoint = false}) {
+  for (var i = 0; i < points.length; i += 3) {
+    final x = points[i], y = points[i + 1], z = points[i + 2];
+    out[i] = transform[0] * x + transform[3] * y + transform[6] * z +
+        transform[9];
+    out[i + 1] = transform[1] * x + transform[4] * y + transform[7] * z +
+        transform[10];
+    out[i + 2] = transform[2] * x + transform[5] * y + transform[8] * z +
+        transform[11];
+    if (callPerPoint) _noop(nullptr);
+  }
+}
+
+// [planes] holds a normal and a distance, four floats per plane
+int _cullAabbsScalar(Float32List aabbs, Float32List planes, Uint8List visible,
+    {bool callPerBox = false}) {
+  var kept = 0;
+  for (var box = 0; box < aabbs.length ~/ 6; ++box) {
+    final src = box * 6;
+    final extentX = (aabbs[src + 3] * 0.5).abs();
+    final extentY = (aabbs[src + 4] * 0.5).abs();
+    final extentZ = (aabbs[src + 5] * 0.5).abs();
+    final centerX = aabbs[src] + aabbs[src + 3] * 0.5;
+    final centerY = aabbs[src + 1] + aabbs[src + 4] * 0.5;
+    final centerZ = aabbs[src + 2] + aabbs[src + 5] * 0.5;
+
+    var isVisible = true;
+    for (var p = 0; p < planes.length && isVisible; p += 4) {
+      final distance = centerX * planes[p] +
+          centerY * planes[p + 1] +
+          centerZ * planes[p + 2] -
+          planes[p + 3];
+      final radius = extentX * planes[p].abs() +
+          extentY * planes[p + 1].abs() +
+          extentZ * planes[p + 2].abs();
+      isVisible = distance <= radius;
+    }
+    if (callPerBox) _noop(nullptr);
+
+    visible[box] = isVisible ? 1 : 0;
+    if (isVisible) kept++;
+  }
+  return kept;
+}
+
+void main() {
+  final random = Random(42);
+  double coordinate() => random.nextDouble() * 200.0 - 100.0;
+
+  // A rotation around y by 30 degrees, a scale of 2 and a translation
+  final sin30 = sin(pi / 6), cos30 = cos(pi / 6);
+  final transform = Float32List.fromList([
+    2 * cos30, 0, -2 * sin30, //
+    0, 2, 0,
+    2 * sin30, 0, 2 * cos30,
+    10, 20, 30,
+  ]);
+  final column0 = Float32x4(transform[0], transform[1], transform[2], 0);
+  final column1 = Float32x4(transform[3], transform[4], transform[5], 0);
+  final column2 = Float32x4(transform[6], transform[7], transform[8], 0);
+  final origin = Float32x4(transform[9], transform[10], transform[11], 0);
+
+  final points = Float32List(_count * 3);
+  for (var i = 0; i < points.length; ++i) {
+    points[i] = coordinate();
+  }
+  final transformed = Float32List(points.length);
+
+  // Boxes spread over twice the size of a cube bounded by six planes, so
+  // most are culled by one of them
+  final aabbs = Float32List(_count * 6);
+  for (var box = 0; box < _count; ++box) {
+    for (var axis = 0; axis < 3; ++axis) {
+      aabbs[box * 6 + axis] = coordinate();
+      aabbs[box * 6 + 3 + axis] = random.nextDouble() * 5.0;
+    }
+  }
+  final planeList = [
+    Float32x4(1, 0, 0, 50),
+    Float32x4(-1, 0, 0, 50),
+    Float32x4(0, 1, 0, 50),
+    Float32x4(0, -1, 0, 50),
+    Float32x4(0, 0, 1, 50),
+    Float32x4(0, 0, -1, 50),
+  ];
+  final planes = Float32List(planeList.length * 4);
+  for (var i = 0; i < planeList.length; ++i) {
+    planes
+      ..[i * 4] = planeList[i].x
+      ..[i * 4 + 1] = planeList[i].y
+      ..[i * 4 + 2] = planeList[i].z
+      ..[i * 4 + 3] = planeList[i].w;
+  }
+  final visible = Uint8List(_count);
+
+  print('Per batch of $_count values:');
+  measure('transformPoints, Float32x4', _iterations,
+      () => transformPoints(column0, column1, column2, origin, points,
+          transformed));
+  measure('transformPoints, scalar', _iterations,
+      () => _transformPointsScalar(transform, points, transformed));
+  measure('transformPoints, scalar with an FFI call per point', _iterations,
+      () => _transformPointsScalar(transform, points, transformed,
+          callPerPoint: true));
+
+  measure('cullAabbs, Float32x4', _iterations,
+      () => cullAabbs(aabbs, planeList, visible));
+  measure('cullAabbs, scalar', _iterations,
+      () => _cullAabbsScalar(aabbs, planes, visible));
+  measure('cullAabbs, scalar with an FFI call per box', _iterations,
+      () => _cullAabbsScalar(aabbs, planes, visible, callPerBox: true));
+}
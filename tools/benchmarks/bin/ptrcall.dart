@@ -0,0 +1,81 @@
+// ignore_for_file: implementation_imports
+
+import 'dart:ffi';
+
+import 'package:ffi/ffi.dart';
+import 'package:godot_dart/src/core/gdextension_ffi_bindings.dart';
+import 'package:godot_dart_benchmarks/benchmarks.dart';
+
+// Compares calling GDExtension interface functions the way GodotDart used to,
+// with asFunction on every call, against resolving them once into late final
+// fields. The interface is a mock backed by the C allocator: each call
+// allocates what the real one would need, a Variant to initialize or the
+// argument array of a ptrcall, and the memory is really freed, by the mock
+// entry for variant_new_nil and after the call for ptrcall. The numbers are the
+// cost of the call plus that allocation, which both ways pay the same.
+
+const _iterations = 10000000;
+
+// Matches the size of a Variant in Godot's 64 bit builds
+const _variantSize = 24;
+
+final _allocate =
+    nativeAllocate.asFunction<Pointer<Void> Function(int)>(isLeaf: true);
+final _free =
+    nativeFree.asFunction<void Function(Pointer<Void>)>(isLeaf: true);
+
+/// Resolves interface entries once, as GodotDart does.
+class _ResolvedInterface {
+  final Pointer<GDExtensionInterface> interface;
+
+  _ResolvedInterface(this.interface);
+
+  late final variantNewNil = interface.ref.variant_new_nil
+      .asFunction<void Function(GDExtensionVariantPtr)>(isLeaf: true);
+  late final objectMethodBindPtrCall = interface
+      .ref.object_method_bind_ptrcall
+      .asFunction<
+          void Function(GDExtensionMethodBindPtr, GDExtensionObjectPtr,
+              Pointer<GDExtensionConstTypePtr>, GDExtensionTypePtr)>();
+}
+
+// The mock's variant_new_nil frees the Variant it's given
+void _variantNewNilPerCall(Pointer<GDExtensionInterface> interface) {
+  final newNil = interface.ref.variant_new_nil
+      .asFunction<void Function(GDExtensionVariantPtr)>();
+  newNil(_allocate(_variantSize));
+}
+
+void _ptrCallPerCall(Pointer<GDExtensionInterface> interface) {
+  final callFunc = interface.ref.object_method_bind_ptrcall.asFunction<
+      void Function(GDExtensionMethodBindPtr, GDExtensionObjectPtr,
+          Pointer<GDExtensionConstTypePtr>, GDExtensionTypePtr)>();
+  final args = _allocate(4 * sizeOf<GDExtensionConstTypePtr>());
+  callFunc(nullptr, nullptr, args.cast(), nullptr);
+  _free(args);
+}
+
+void _ptrCallResolved(_ResolvedInterface resolved) {
+  final args = _allocate(4 * sizeOf<GDExtensionConstTypePtr>());
+  resolved.objectMethodBindPtrCall(nullptr, nullptr, args.cast(), nullptr);
+  _free(args);
+}
+
+void main() {
+  final interface = calloc<GDExtensionInterface>();
+  interface.ref
+    ..variant_new_nil = nativeFree
+    ..object_method_bind_ptrcall = nativeFree.cast();
+  final resolved = _ResolvedInterface(interface);
+
+  measure('variant_new_nil, asFunction per call', _iterations,
+      () => _variantNewNilPerCall(interface));
+  measure('variant_new_nil, resolved once (leaf)', _iterations,
+      () => resolved.variantNewNil(_allocate(_variantSize)));
+  measure('object_method_bind_ptrcall, asFunction per call', _iterations,
+      () => _ptrCallPerCall(interface));
+  measure('object_method_bind_ptrcall, resolved once', _iterations,
+      () => _ptrCallResolved(resolved));
+
+  calloc.free(interface);
+}
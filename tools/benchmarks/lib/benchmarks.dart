@@ -0,0 +1,40 @@
+import 'dart:ffi';
+import 'dart:io';
+
+/// Runs [body] [iterations] times after a warm up, and prints the average
+/// time each run took.
+void measure(String name, int iterations, void Function() body) {
+  for (var i = 0; i < iterations ~/ 10; ++i) {
+    body();
+  }
+
+  final stopwatch = Stopwatch()..start();
+  for (var i = 0; i < iterations; ++i) {
+    body();
+  }
+  stopwatch.stop();
+
+  final nanoseconds = stopwatch.elapsedMicroseconds * 1000 / iterations;
+  print('${name.padRight(48)} ${nanoseconds.toStringAsFixed(1)} ns');
+}
+
+final _allocatorLibrary = Platform.isWindows
+    ? DynamicLibrary.open('ole32.dll')
+    : DynamicLibrary.process();
+
+/// The C library's `malloc`, or `CoTaskMemAlloc` on Windows, which pairs with
+/// [nativeFree].
+final Pointer<NativeFunction<Pointer<Void> Function(IntPtr)>> nativeAllocate =
+    _allocatorLibrary
+        .lookup(Platform.isWindows ? 'CoTaskMemAlloc' : 'malloc');
+
+/// The C library's `free`, or `CoTaskMemFree` on Windows.
+///
+/// Mock interfaces point their entries at it. Passed memory from
+/// [nativeAllocate] it does the allocator's real work of releasing it, and
+/// passed null it does nothing, so a call only costs the FFI transition. The
+/// calling conventions of the 64 bit platforms Godot supports leave extra
+/// arguments to the caller, so it can stand in for functions that take more
+/// than one.
+final Pointer<NativeFunction<Void Function(Pointer<Void>)>> nativeFree =
+    _allocatorLibrary.lookup(Platform.isWindows ? 'CoTaskMemFree' : 'free');
@@ -8,8 +8,10 @@ import 'src/generators/builtin_type_generator.dart';
 import 'src/generators/engine_type_generator.dart';
 import 'src/generators/native_structures_generator.dart';
 import 'src/godot_api_info.dart';
+import 'src/godot_names.dart';
 import 'src/string_extensions.dart';
 import 'src/type_helpers.dart';
+import 'src/value_types.dart';
 
 const String templateLocation = 'lib/src/templates';
 
@@ -42,6 +44,8 @@ Future<void> generate(GenerationOptions options) async {
 
   // TODO: Remove Output Directory
   final apiInfo = GodotApiInfo.fromJson(jsonApi);
+  findValueTypes(apiInfo, options.buildConfig);
+
   print('Generating builtins...');
   await generateBuiltinBindings(
       apiInfo, options.outputDirectory, options.buildConfig);
@@ -57,6 +61,10 @@ Future<void> generate(GenerationOptions options) async {
   print('Generating native structures...');
   await generateNativeStructures(
       apiInfo, options.outputDirectory, options.buildConfig);
+
+  // Written last so it has every name referenced by the generators above
+  print('Generating Godot names...');
+  await godotNames.write(options.outputDirectory);
 }
 
 Future<void> generateGlobalConstants(
@@ -1,9 +1,11 @@
+import 'dart:convert';
 import 'dart:io';
 
 import 'godot_api_info.dart';
 import 'string_extensions.dart';
 import 'type_helpers.dart';
 import 'type_info.dart';
+import 'value_types.dart';
 
 const String header = '''// AUTO GENERATED FILE, DO NOT EDIT.
 //
@@ -23,6 +25,7 @@ void writeImports(IOSink out, GodotApiInfo api, Map<String, dynamic> classApi,
 
   out.write('''
 import 'dart:ffi';
+import 'dart:typed_data';
 
 import 'package:ffi/ffi.dart';
 import 'package:meta/meta.dart';
@@ -30,7 +33,9 @@ import 'package:meta/meta.dart';
 import '../../core/core_types.dart';
 import '../../core/gdextension_ffi_bindings.dart';
 import '../../core/gdextension.dart';
+import '../../core/godot_arena.dart';
 import '../../core/type_info.dart';
+import '../godot_names.dart';
 import '${forVariant ? '' : '../variant/'}string_name.dart';
 ${forVariant ? '' : "import '../../variant/variant.dart';"}
 
@@ -59,6 +64,21 @@ ${forVariant ? '' : "import '../../variant/variant.dart';"}
 }
 
 void argumentAllocation(ArgumentInfo typeInfo, IOSink out) {
+  final layout = valueTypeOf(typeInfo);
+  if (layout != null) {
+    // Value types are written to the arena
+    final name = typeInfo.name;
+    if (typeInfo.isOptional) {
+      out.write(
+          '      final ${name}Ptr = $name == null ? nullptr : arena.allocate<Uint8>(${layout.size});\n');
+      out.write('      $name?.copyToNative(${name}Ptr.cast());\n');
+    } else {
+      out.write(
+          '      final ${name}Ptr = arena.allocate<Uint8>(${layout.size});\n');
+      out.write('      $name.copyToNative(${name}Ptr.cast());\n');
+    }
+    return;
+  }
   if (!typeInfo.needsAllocation) return;
 
   var ffiType = getFFIType(typeInfo);
@@ -76,6 +96,11 @@ bool writeReturnAllocation(
     out.write(
         'final retPtr = arena.allocate<GDExtensionObjectPtr>(sizeOf<GDExtensionObjectPtr>());\n');
     return true;
+  } else if (valueTypeOf(returnType) != null) {
+    // Value types are copied out of a native slot after the call
+    out.write(
+        'final retPtr = arena.allocate<Uint8>(${valueTypeOf(returnType)!.size});\n');
+    return true;
   } else {
     final nativeType = getFFIType(returnType);
     if (nativeType == null) {
@@ -89,19 +114,43 @@ bool writeReturnAllocation(
   }
 }
 
+/// The expression for the value returned in the slot allocated by
+/// [writeReturnAllocation], when it returns true.
+String returnValueFromSlot(ArgumentInfo returnType) {
+  if (returnType.typeInfo.typeCategory == TypeCategory.engineClass) {
+    return 'retPtr == nullptr ? null : ${returnType.dartType}.fromOwner(retPtr.value)';
+  } else if (valueTypeOf(returnType) != null) {
+    return '${returnType.dartType}.fromPointer(retPtr.cast())';
+  }
+  return 'retPtr.value';
+}
+
+/// The pointer passed to Godot for [argument] inside a [withAllocationBlock]
+String argumentPointer(ArgumentInfo argument) {
+  if (argument.needsAllocation || valueTypeOf(argument) != null) {
+    return '${argument.name}Ptr.cast()';
+  } else if (argument.isOptional) {
+    return '${argument.name}?.nativePtr.cast() ?? nullptr';
+  }
+  return '${argument.name}.nativePtr.cast()';
+}
+
 void withAllocationBlock(
   List<ArgumentInfo> arguments,
   ArgumentInfo? retInfo,
   IOSink out,
-  void Function(String indent) writeBlock,
-) {
+  void Function(String indent) writeBlock, {
+  bool forceArena = false,
+}) {
   var indent = '';
-  var needsArena = retInfo?.typeInfo.typeCategory != TypeCategory.voidType ||
-      arguments.any((arg) => arg.needsAllocation);
+  // Value types are copied to scratch memory when passed, so they need one too
+  var needsArena = forceArena ||
+      retInfo?.typeInfo.typeCategory != TypeCategory.voidType ||
+      arguments.any((arg) => arg.needsAllocation || valueTypeOf(arg) != null);
   if (needsArena) {
     indent = '  ';
     out.write('''
-    using((arena) {
+    gde.scratch.scope((arena) {
 ''');
     for (final arg in arguments) {
       argumentAllocation(arg, out);
@@ -119,6 +168,18 @@ void argumentFree(ArgumentInfo argument, IOSink out) {
   out.write('    malloc.free(${argument.name!.toLowerCamelCase()}Ptr);\n');
 }
 
+/// The 64-bit FNV-1a hash of [name] as a hex literal, used to look up interned
+/// StringNames without hashing at runtime. Must match `stringNameHash` in
+/// godot_dart and `gd_string_name_hash` in the native library.
+String stringNameHashLiteral(String name) {
+  var hash = 0xcbf29ce484222325;
+  for (final byte in utf8.encode(name)) {
+    hash ^= byte;
+    hash *= 0x100000001b3;
+  }
+  return '0x${hash.toUnsigned(64).toRadixString(16).padLeft(16, '0')}';
+}
+
 /// Generate a constructor name from arguments types. In the case
 /// of a single argument constructor of the same type, the constructor
 /// is called 'copy'. Otherwise it is named '.from{ArgType1}{ArgType2}'
@@ -349,10 +410,7 @@ String convertPtrArgument(
 
 String writePtrReturn(ArgumentInfo argument, {String indent = '    '}) {
   if (argument.typeInfo.godotType == 'String') {
-    var ret = '${indent}final retGdString = GDString.fromString(ret);\n';
-    ret +=
-        '${indent}gde.dartBindings.variantCopyToNative(retPtr, retGdString);\n';
-    return ret;
+    return '${indent}GDString.copyToNative(ret, retPtr);\n';
   }
 
   var ret = indent;
@@ -363,7 +421,15 @@ String writePtrReturn(ArgumentInfo argument, {String indent = '    '}) {
           argument.isOptional ? 'ret?.nativePtr ?? nullptr' : 'ret.nativePtr';
       break;
     case TypeCategory.builtinClass:
-      ret += 'gde.dartBindings.variantCopyToNative(retPtr, ret)';
+      if (valueTypeOf(argument) != null) {
+        ret += 'ret.copyToNative(retPtr)';
+      } else if (argument.typeInfo.godotType == 'Variant') {
+        // The Dart Variant destroys its value, so Godot gets a real copy
+        ret += 'gde.variantDestroy(retPtr.cast());\n';
+        ret += '${indent}gde.variantNewCopy(retPtr.cast(), ret.nativePtr.cast())';
+      } else {
+        ret += 'gde.dartBindings.variantCopyToNative(retPtr, ret)';
+      }
       break;
     case TypeCategory.primitive:
       final castType =
@@ -5,21 +5,61 @@
 /// Create GDString from String
 String gdStringFromString() {
   return '''
-  GDString.fromString(String string) {
-    final native = string.toNativeUtf8();
+  GDString.fromString(String string) : _opaque = GodotArena.allocate(_size, _variantType) {
+    gde.dartBindings.stringToGDString(string, nativePtr.cast());
+  }
+
+  static const int _maxCachedLength = 64;
+  static const int _maxCachedStrings = 256;
+  // Least recently used first, as Dart maps keep insertion order
+  static final _cache = <String, GDString>{};
+
+  /// Returns a GDString for [string]. Short strings are kept in a small least
+  /// recently used cache, so the ones that keep coming back, like literals
+  /// returned from methods, are converted once while one-off strings pass
+  /// through without pinning anything.
+  ///
+  /// The result is only valid until the next call, which may destroy it to
+  /// make room. It must be copied with the String copy constructor (see
+  /// [copyToNative]) right away, and never modified or retained.
+  static GDString cached(String string) {
+    if (string.length > _maxCachedLength) {
+      return GDString.fromString(string);
+    }
+
+    var gdString = _cache.remove(string);
+    if (gdString == null) {
+      if (_cache.length >= _maxCachedStrings) {
+        final evicted = _cache.remove(_cache.keys.first)!;
+        _destructor(evicted.nativePtr.cast());
+      }
+      // Cached strings outlive any frame scope
+      gdString = GodotArena.persist(() => GDString.fromString(string));
+    }
+    _cache[string] = gdString;
+    return gdString;
+  }
 
-    final f = gde.interface.ref.string_new_with_utf8_chars
-      .asFunction<void Function(GDExtensionStringPtr, Pointer<Char>)>();
-    f(nativePtr.cast(), native.cast());
+  static final _destructor = _bindings.destructor!
+      .asFunction<void Function(GDExtensionTypePtr)>(isLeaf: true);
 
-    malloc.free(native);
+  /// Write [string] as a Godot String to [dest], which must point to
+  /// uninitialized (or empty) String storage, such as a return slot.
+  static void copyToNative(String string, Pointer<Void> dest) {
+    if (string.length > _maxCachedLength) {
+      gde.dartBindings.stringToGDString(string, dest);
+    } else {
+      gde.callBuiltinConstructor(_bindings.constructor_1!, dest.cast(), [
+        cached(string).nativePtr.cast(),
+      ]);
+    }
   }
 ''';
 }
 
 String stringNameFromString() {
   return '''
-  StringName.fromString(String string) {
+  StringName.fromString(String string) : _opaque = GodotArena.allocate(_size, _variantType) {
     final gdString = GDString.fromString(string);
     gde.callBuiltinConstructor(_bindings.constructor_2!, nativePtr.cast(), [
       gdString.nativePtr.cast(),
@@ -28,6 +68,22 @@ String stringNameFromString() {
 ''';
 }
 
+String stringNameInterned() {
+  return '''
+  /// Create a StringName from the process-wide interned copy of [string],
+  /// which costs a single lookup once the name has been interned.
+  StringName.interned(String string, [int? hash])
+      : _opaque = GodotArena.allocate(_size, _variantType) {
+    if (!gde.dartBindings.copyInternedStringName(string, hash, nativePtr)) {
+      final gdString = GDString.fromString(string);
+      gde.callBuiltinConstructor(_bindings.constructor_2!, nativePtr.cast(), [
+        gdString.nativePtr.cast(),
+      ]);
+    }
+  }
+''';
+}
+
 String gdStringToDartString() {
   return '''
   String toDartString() {
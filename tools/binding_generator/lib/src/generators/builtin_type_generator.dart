@@ -5,9 +5,12 @@ import 'package:path/path.dart' as path;
 import '../common_helpers.dart';
 import '../gdstring_additional.dart';
 import '../godot_api_info.dart';
+import '../godot_names.dart';
+import '../math_additional.dart';
 import '../string_extensions.dart';
 import '../type_helpers.dart';
 import '../type_info.dart';
+import '../value_types.dart';
 
 Future<void> generateBuiltinBindings(
   GodotApiInfo api,
@@ -41,6 +44,7 @@ Future<void> generateBuiltinBindings(
     // Check for types we've implemented ourselves
 
     final size = builtinSizes[builtin.godotType]!;
+    final layout = valueTypes[builtin.godotType];
 
     final destPath =
         path.join(targetDir, '${builtin.godotType.toSnakeCase()}.dart');
@@ -50,22 +54,32 @@ Future<void> generateBuiltinBindings(
 
     // Imports
     writeImports(out, api, builtin.api, true);
+    out.write(mathImports(builtin.godotType));
 
     // Class
     out.write('''
 
-class ${builtin.dartType} extends BuiltinType {
+class ${builtin.dartType} extends ${layout == null ? 'BuiltinType' : 'BuiltinValueType'} {
   static const int _size = $size;
+  static const int _variantType = GDExtensionVariantType.GDEXTENSION_VARIANT_TYPE_${builtin.godotType.toUpperSnakeCase()};
   static final _${builtin.godotType}Bindings _bindings = _${builtin.godotType}Bindings();
   static late TypeInfo typeInfo;
   
   @override
   TypeInfo get staticTypeInfo => typeInfo;
-  
-  final Pointer<Uint8> _opaque = calloc<Uint8>(_size);
+''');
+    if (layout != null) {
+      _writeValueStorage(out, builtin, layout);
+    } else {
+      out.write('''
+  final Pointer<Uint8> _opaque;
 
   @override
   Pointer<Uint8> get nativePtr => _opaque;
+''');
+    }
+
+    out.write('''
 
   static void initBindingsConstructorDestructor() {
 ''');
@@ -89,8 +103,8 @@ class ${builtin.dartType} extends BuiltinType {
     initBindingsConstructorDestructor();
 
     typeInfo = TypeInfo(
-      StringName.fromString('${builtin.godotType}'), 
-      variantType: GDExtensionVariantType.GDEXTENSION_VARIANT_TYPE_${builtin.godotType.toUpperSnakeCase()},
+      ${godotNames.reference(builtin.godotType)}, 
+      variantType: _variantType,
       size: _size,
     );
 ''');
@@ -98,76 +112,111 @@ class ${builtin.dartType} extends BuiltinType {
     final members = builtin.api['members'] as List<dynamic>? ?? <dynamic>[];
     for (Map<String, dynamic> member in members) {
       var memberName = member['name'] as String;
+      if (layout?.member(memberName) != null) continue;
       out.write(
           '''  _bindings.member${memberName.toUpperCamelCase()}Getter = gde.variantGetPtrGetter(
         GDExtensionVariantType.GDEXTENSION_VARIANT_TYPE_${builtin.godotType.toUpperSnakeCase()},
-        StringName.fromString('$memberName'),
+        ${godotNames.reference(memberName)},
       );''');
       out.write(
           '''  _bindings.member${memberName.toUpperCamelCase()}Setter = gde.variantGetPtrSetter(
         GDExtensionVariantType.GDEXTENSION_VARIANT_TYPE_${builtin.godotType.toUpperSnakeCase()},
-        StringName.fromString('$memberName'),
+        ${godotNames.reference(memberName)},
       );''');
     }
 
+    final dartMethods = hasDartMath(builtin.godotType)
+        ? dartMathMethods[builtin.godotType] ?? const <String>{}
+        : const <String>{};
     for (Map<String, dynamic> method in builtin.api['methods']) {
       var methodName = method['name'] as String;
+      if (dartMethods.contains(methodName)) continue;
       var dartMethodName = escapeMethodName(methodName);
       out.write(
           '''    _bindings.method${dartMethodName.toUpperCamelCase()} = gde.variantGetBuiltinMethod(
       GDExtensionVariantType.GDEXTENSION_VARIANT_TYPE_${builtin.godotType.toUpperSnakeCase()}, 
-      StringName.fromString('$methodName'), 
+      ${godotNames.reference(methodName)}, 
       ${method['hash']},
     );
 ''');
     }
 
+    if (layout != null) {
+      // Godot defines the default value, which isn't always zero
+      final defaultConstructor = (builtin.api['constructors'] as List<dynamic>)
+          .firstWhere((dynamic c) => c['arguments'] == null);
+      out.write('''
+    _defaultComponents = gde.scratch.scope((arena) {
+      final ptr = arena.allocate<Uint8>(_size);
+      gde.callBuiltinConstructor(_bindings.constructor_${defaultConstructor['index']}!, ptr.cast(), []);
+      return ${builtin.dartType}.fromPointer(ptr.cast()).components;
+    });
+''');
+    }
+
     out.write('  }\n');
 
     // Constructors
-    out.write('''
-  ${builtin.dartType}.fromPointer(Pointer<Void> ptr) {
+    if (layout != null) {
+      _writeValueConstructors(out, builtin, layout);
+    } else {
+      out.write('''
+  ${builtin.dartType}.fromPointer(Pointer<Void> ptr) : _opaque = GodotArena.allocate(_size, _variantType) {
     gde.dartBindings.variantCopyFromNative(this, ptr);
   }
+
+  /// Wrap storage owned by someone else, which must outlive this object.
+  ${builtin.dartType}.unowned(this._opaque) : super.unowned();
 ''');
+    }
 
     for (Map<String, dynamic> constructor in builtin.api['constructors']) {
       int index = constructor['index'];
       final constructorName =
           getConstructorName(builtin.godotType, constructor);
-      out.write('\n  ${builtin.dartType}$constructorName(');
       final arguments =
           (constructor['arguments'] as List<dynamic>? ?? <dynamic>[])
               .map((dynamic e) => api.getArgumentInfo(e))
               .toList();
+      if (layout != null &&
+          _writeDartValueConstructor(
+              out, builtin, layout, constructorName, arguments)) {
+        continue;
+      }
+
+      // Value types are constructed by Godot in scratch memory, then copied
+      final initializer = layout == null
+          ? '_opaque = GodotArena.allocate(_size, _variantType)'
+          : 'components = ${layout.listType}(${layout.componentCount}), super.unowned()';
+      out.write('\n  ${builtin.dartType}$constructorName(');
       if (arguments.isNotEmpty) {
         out.write('\n');
         // Parameter list
         for (final argument in arguments) {
           out.write('    final ${argument.fullDartType} ${argument.name},\n');
         }
-        out.write('  ) {\n');
+        out.write('  ) : $initializer {\n');
       } else {
-        out.write(') {\n');
+        out.write(') : $initializer {\n');
       }
 
-      withAllocationBlock(arguments, null, out, (ei) {
+      withAllocationBlock(arguments, null, out, forceArena: layout != null,
+          (ei) {
+        if (layout != null) {
+          out.write('    ${ei}final ptr = arena.allocate<Uint8>(_size);\n');
+        }
         out.write('''
-    ${ei}gde.callBuiltinConstructor(_bindings.constructor_$index!, nativePtr.cast(), [
+    ${ei}gde.callBuiltinConstructor(_bindings.constructor_$index!, ${layout == null ? 'nativePtr' : 'ptr'}.cast(), [
 ''');
         for (final argument in arguments) {
-          if (argument.needsAllocation) {
-            out.write('      $ei${argument.name}Ptr.cast(),\n');
-          } else if (argument.isOptional) {
-            out.write(
-                '      $ei${argument.name}?.nativePtr.cast() ?? nullptr,\n');
-          } else {
-            out.write('      $ei${argument.name}.nativePtr.cast(),\n');
-          }
+          out.write('      $ei${argumentPointer(argument)},\n');
         }
         out.write('''
     $ei]); 
 ''');
+        if (layout != null) {
+          out.write('    ${ei}_copyFromNative(ptr.cast());\n');
+        }
       });
 
       out.write('  }\n');
@@ -178,11 +227,18 @@ class ${builtin.dartType} extends BuiltinType {
       out.write(gdStringToDartString());
     } else if (builtin.godotType == 'StringName') {
       out.write(stringNameFromString());
+      out.write(stringNameInterned());
     }
 
     // Members
     for (Map<String, dynamic> member in members) {
       final memberInfo = api.getMemberInfo(member);
+      final storedMember = layout?.member(member['name'] as String);
+      if (storedMember != null) {
+        _writeValueMember(out, memberInfo, storedMember);
+        continue;
+      }
+
       out.write('''
 
   ${memberInfo.dartType} get ${memberInfo.name} {
@@ -195,17 +251,15 @@ class ${builtin.dartType} extends BuiltinType {
       }
       withAllocationBlock([], memberInfo, out, (ei) {
         bool extractReturnValue = writeReturnAllocation(api, memberInfo, out);
+        if (layout != null) {
+          _writeSelfCopy(out, ei);
+        }
         out.write('''
     ${ei}final f = _bindings.member${memberInfo.name!.toUpperCamelCase()}Getter!.asFunction<void Function(GDExtensionConstTypePtr, GDExtensionTypePtr)>(isLeaf: true);
-    ${ei}f(nativePtr.cast(), retPtr.cast());
+    ${ei}f(${layout == null ? 'nativePtr' : 'selfPtr'}.cast(), retPtr.cast());
 ''');
         if (extractReturnValue) {
-          if (memberInfo.typeInfo.typeCategory == TypeCategory.engineClass) {
-            out.write(
-                '      retVal = retPtr == nullptr ? null : ${memberInfo.dartType}.fromOwner(retPtr.value);\n');
-          } else {
-            out.write('      retVal = retPtr.value;\n');
-          }
+          out.write('      retVal = ${returnValueFromSlot(memberInfo)};\n');
         }
       });
 
@@ -222,22 +276,23 @@ class ${builtin.dartType} extends BuiltinType {
 
   set ${memberInfo.name}(${memberInfo.dartType} value) {
 ''');
-      withAllocationBlock([memberInfo], null, out, (ei) {
-        String valueCast;
-        if (memberInfo.needsAllocation) {
-          valueCast = '${memberInfo.name}Ptr.cast()';
-        } else if (memberInfo.typeInfo.godotType == 'String') {
-          valueCast =
-              'GDString.fromString(${memberInfo.name}).nativePtr.cast()';
-        } else if (memberInfo.isOptional) {
-          valueCast = '${memberInfo.name}?.nativePtr.cast() ?? nullptr';
-        } else {
-          valueCast = '${memberInfo.name}.nativePtr.cast()';
+      // Setting a computed member of a value type changes the stored ones,
+      // which are copied back from scratch memory
+      withAllocationBlock([memberInfo], null, out, forceArena: layout != null,
+          (ei) {
+        if (layout != null) {
+          _writeSelfCopy(out, ei);
         }
+        final valueCast = memberInfo.typeInfo.godotType == 'String'
+            ? 'GDString.fromString(${memberInfo.name}).nativePtr.cast()'
+            : argumentPointer(memberInfo);
         out.write('''
     ${ei}final f = _bindings.member${memberInfo.name!.toUpperCamelCase()}Setter!.asFunction<void Function(GDExtensionConstTypePtr, GDExtensionTypePtr)>(isLeaf: true);
-    ${ei}f(nativePtr.cast(), $valueCast);
+    ${ei}f(${layout == null ? 'nativePtr' : 'selfPtr'}.cast(), $valueCast);
 ''');
+        if (layout != null) {
+          out.write('    ${ei}_copyFromNative(selfPtr.cast());\n');
+        }
       });
 
       out.write('''
@@ -245,8 +300,14 @@ class ${builtin.dartType} extends BuiltinType {
 ''');
     }
 
+    if (layout != null) {
+      _writeValueOperators(out, builtin, layout);
+      out.write(mathAdditional(builtin.godotType));
+    }
+
     // Methods
     for (Map<String, dynamic> method in builtin.api['methods']) {
+      if (dartMethods.contains(method['name'])) continue;
       var methodName = escapeMethodName(method['name'] as String);
       final signature = makeSignature(api, method);
       out.write('''
@@ -266,41 +327,42 @@ class ${builtin.dartType} extends BuiltinType {
               '    ${retInfo.fullDartType} retVal = ${getDefaultValueForAgument(retInfo)};\n');
         }
       }
-      withAllocationBlock(arguments, retInfo, out, (ei) {
+      // Value types pass a copy of themselves, which non-const methods change
+      final isStatic = method['is_static'] == true;
+      final copiesSelf = layout != null && !isStatic;
+      withAllocationBlock(arguments, retInfo, out, forceArena: copiesSelf,
+          (ei) {
         bool extractReturnValue = false;
         if (retInfo.typeInfo.typeCategory != TypeCategory.voidType) {
           extractReturnValue = writeReturnAllocation(api, retInfo, out);
         }
+        if (copiesSelf) {
+          _writeSelfCopy(out, ei);
+        }
         final retParam = retInfo.typeInfo.typeCategory == TypeCategory.voidType
             ? 'nullptr'
             : 'retPtr.cast()';
-        final thisParam =
-            method['is_static'] == true ? 'nullptr' : 'nativePtr.cast()';
+        final thisParam = isStatic
+            ? 'nullptr'
+            : copiesSelf
+                ? 'selfPtr.cast()'
+                : 'nativePtr.cast()';
         out.write('''
     ${ei}gde.callBuiltinMethodPtr(_bindings.method${methodName.toUpperCamelCase()}, $thisParam, $retParam, [
 ''');
         for (final argument in arguments) {
-          if (argument.needsAllocation) {
-            out.write('      $ei${argument.name}Ptr.cast(),\n');
-          } else if (argument.isOptional) {
-            out.write(
-                '      $ei${argument.name}?.nativePtr.cast() ?? nullptr,\n');
-          } else {
-            out.write('      $ei${argument.name}.nativePtr.cast(),\n');
-          }
+          out.write('      $ei${argumentPointer(argument)},\n');
         }
 
         out.write('''
     $ei]);
 ''');
+        if (copiesSelf && method['is_const'] != true) {
+          out.write('    ${ei}_copyFromNative(selfPtr.cast());\n');
+        }
         if (retInfo.typeInfo.typeCategory != TypeCategory.voidType &&
             extractReturnValue) {
-          if (retInfo.typeInfo.typeCategory == TypeCategory.engineClass) {
-            out.write(
-                '      retVal = retPtr == nullptr ? null : ${retInfo.dartType}.fromOwner(retPtr.value);\n');
-          } else {
-            out.write('      retVal = retPtr.value;\n');
-          }
+          out.write('      retVal = ${returnValueFromSlot(retInfo)};\n');
         }
       });
 
@@ -336,12 +398,14 @@ class _${builtin.godotType}Bindings {\n''');
     }
     for (Map<String, dynamic> member in members) {
       var memberName = member['name'] as String;
+      if (layout?.member(memberName) != null) continue;
       memberName = memberName.toUpperCamelCase();
       out.write('''  GDExtensionPtrGetter? member${memberName}Getter;\n''');
       out.write('''  GDExtensionPtrSetter? member${memberName}Setter;\n''');
     }
     for (Map<String, dynamic> method in builtin.api['methods']) {
       var methodName = method['name'] as String;
+      if (dartMethods.contains(methodName)) continue;
       methodName = methodName.toUpperCamelCase();
       out.write('''  GDExtensionPtrBuiltInMethod? method$methodName;\n''');
     }
@@ -359,3 +423,242 @@ class _${builtin.godotType}Bindings {\n''');
 
   await out.close();
 }
+
+/// Value types pass a copy of themselves, written to the arena as `selfPtr`
+void _writeSelfCopy(IOSink out, String indent) {
+  out.write('''
+    ${indent}final selfPtr = arena.allocate<Uint8>(_size);
+    ${indent}copyToNative(selfPtr.cast());
+''');
+}
+
+void _writeValueStorage(
+    IOSink out, TypeInfo builtin, ValueTypeLayout layout) {
+  final count = layout.componentCount;
+  out.write('''
+  static late final ${layout.listType} _defaultComponents;
+  static final Finalizer<Pointer<Uint8>> _copyFinalizer =
+      Finalizer((ptr) => calloc.free(ptr));
+
+  /// The components of this ${builtin.dartType}, in the order Godot stores
+  /// them.
+  final ${layout.listType} components;
+
+  /// A copy of this ${builtin.dartType} in scratch memory, valid until the
+  /// enclosing `gde.scratch.scope` returns. Outside of a scope the copy is
+  /// allocated on the heap instead and lives as long as this object. Changes
+  /// to it are not seen by this object.
+  ///
+  /// Every read makes a new copy. The bindings write value types with
+  /// [copyToNative] instead.
+  @override
+  Pointer<Uint8> get nativePtr {
+    final Pointer<Uint8> ptr;
+    if (gde.scratch.inScope) {
+      ptr = gde.scratch.allocate<Uint8>(_size);
+    } else {
+      ptr = calloc<Uint8>(_size);
+      _copyFinalizer.attach(this, ptr);
+    }
+    copyToNative(ptr.cast());
+    return ptr;
+  }
+
+  /// Write this ${builtin.dartType} to [dest], which must hold at least
+  /// $count ${layout.ffiType}s.
+  @override
+  void copyToNative(Pointer<Void> dest) {
+    final data = dest.cast<${layout.ffiType}>();
+    for (var i = 0; i < $count; ++i) {
+      data[i] = components[i];
+    }
+  }
+
+  void _copyFromNative(Pointer<Void> src) {
+    final data = src.cast<${layout.ffiType}>();
+    for (var i = 0; i < $count; ++i) {
+      components[i] = data[i];
+    }
+  }
+''');
+}
+
+void _writeValueConstructors(
+    IOSink out, TypeInfo builtin, ValueTypeLayout layout) {
+  out.write('''
+  ${builtin.dartType}.fromPointer(Pointer<Void> ptr)
+      : components = ${layout.listType}(${layout.componentCount}),
+        super.unowned() {
+    _copyFromNative(ptr);
+  }
+
+  ${builtin.dartType}.fromComponents(this.components) : super.unowned();
+''');
+}
+
+/// Writes constructors that don't need Godot: the default and copy
+/// constructors, and ones taking every stored member in order. Returns false
+/// if the constructor has to be called through Godot.
+bool _writeDartValueConstructor(
+  IOSink out,
+  TypeInfo builtin,
+  ValueTypeLayout layout,
+  String constructorName,
+  List<ArgumentInfo> arguments,
+) {
+  final className = builtin.dartType;
+  if (arguments.isEmpty) {
+    out.write('''
+
+  $className()
+      : components = ${layout.listType}.fromList(_defaultComponents),
+        super.unowned();
+''');
+    return true;
+  }
+
+  if (constructorName == '.copy') {
+    out.write('''
+
+  $className.copy(final $className ${arguments[0].name})
+      : components = ${layout.listType}.fromList(${arguments[0].name}.components),
+        super.unowned();
+''');
+    return true;
+  }
+
+  if (arguments.length != layout.members.length) return false;
+  for (var i = 0; i < arguments.length; ++i) {
+    final argument = arguments[i];
+    final member = layout.members[i];
+    if (argument.isOptional ||
+        argument.isPointer ||
+        argument.rawName != member.name ||
+        argument.typeInfo.godotType != member.godotType) {
+      return false;
+    }
+  }
+
+  out.write('\n  $className$constructorName(\n');
+  for (final argument in arguments) {
+    out.write('    final ${argument.fullDartType} ${argument.name},\n');
+  }
+  out.write('''
+  )   : components = ${layout.listType}(${layout.componentCount}),
+        super.unowned() {
+''');
+  for (var i = 0; i < arguments.length; ++i) {
+    final member = layout.members[i];
+    if (member.isScalar) {
+      out.write('    components[${member.index}] = ${arguments[i].name};\n');
+    } else {
+      out.write(
+          '    components.setAll(${member.index}, ${arguments[i].name}.components);\n');
+    }
+  }
+  out.write('  }\n');
+  return true;
+}
+
+/// Stored members of value types are read and written in Dart
+void _writeValueMember(
+    IOSink out, ArgumentInfo memberInfo, ValueTypeMember member) {
+  final name = memberInfo.name;
+  final type = memberInfo.dartType;
+  if (member.isScalar) {
+    out.write('''
+
+  $type get $name => components[${member.index}];
+  set $name($type value) => components[${member.index}] = value;
+''');
+  } else {
+    out.write('''
+
+  $type get $name => $type.fromComponents(
+      components.sublist(${member.index}, ${member.index + member.count}));
+  set $name($type value) => components.setAll(${member.index}, value.components);
+''');
+  }
+}
+
+const _valueOperators = {'+', '-', '*', '/', 'unary-'};
+
+/// Names of the methods for operators that also take a scalar
+const _scalarMethods = {
+  '+': 'addScalar',
+  '-': 'subtractScalar',
+  '*': 'scale',
+  '/': 'divideScalar',
+};
+
+/// Vector and Color arithmetic is done in Dart, component by component, for
+/// the operators Godot defines with the same type or a scalar.
+void _writeValueOperators(
+    IOSink out, TypeInfo builtin, ValueTypeLayout layout) {
+  final type = builtin.godotType;
+  if (!type.startsWith('Vector') && type != 'Color') return;
+
+  final className = builtin.dartType;
+  final scalarGodotType = layout.isIntegral ? 'int' : 'float';
+  final operands = <String, Set<String>>{};
+  for (Map<String, dynamic> op in builtin.api['operators'] ?? <dynamic>[]) {
+    final String name = op['name'];
+    final String rightType = op['right_type'] ?? '';
+    if (!_valueOperators.contains(name) || op['return_type'] != type) continue;
+    if (rightType.isEmpty ||
+        rightType == type ||
+        rightType == scalarGodotType) {
+      operands.putIfAbsent(name, () => {}).add(rightType);
+    }
+  }
+
+  final count = layout.componentCount;
+  String apply(String op, String left, String right) =>
+      op == '/' && layout.isIntegral ? '$left ~/ $right' : '$left $op $right';
+
+  void writeLoop(String value) {
+    out.write('''
+    for (var i = 0; i < $count; ++i) {
+      result[i] = $value;
+    }
+''');
+  }
+
+  for (final entry in operands.entries) {
+    final op = entry.key;
+    if (op == 'unary-') {
+      out.write('''
+
+  $className operator -() {
+    final result = ${layout.listType}($count);
+''');
+      writeLoop('-components[i]');
+      out.write('    return $className.fromComponents(result);\n  }\n');
+      continue;
+    }
+
+    final withSelf = entry.value.contains(type);
+    final withScalar = entry.value.contains(scalarGodotType);
+    // Operators take one type, so when Godot also defines the operator with a
+    // scalar, that one becomes a named method
+    final operandType = withSelf ? className : layout.scalarType;
+    out.write('''
+
+  $className operator $op($operandType other) {
+    final result = ${layout.listType}($count);
+''');
+    writeLoop(apply(op, 'components[i]',
+        withSelf ? 'other.components[i]' : 'other'));
+    out.write('    return $className.fromComponents(result);\n  }\n');
+
+    if (withSelf && withScalar) {
+      out.write('''
+
+  $className ${_scalarMethods[op]}(${layout.scalarType} scalar) {
+    final result = ${layout.listType}($count);
+''');
+      writeLoop(apply(op, 'components[i]', 'scalar'));
+      out.write('    return $className.fromComponents(result);\n  }\n');
+    }
+  }
+}
@@ -5,9 +5,11 @@ import 'package:path/path.dart' as path;
 
 import '../common_helpers.dart';
 import '../godot_api_info.dart';
+import '../godot_names.dart';
 import '../string_extensions.dart';
 import '../type_helpers.dart';
 import '../type_info.dart';
+import '../value_types.dart';
 
 Future<void> generateEngineBindings(
   GodotApiInfo api,
@@ -46,6 +48,7 @@ class ${classInfo.dartType} extends $correctedInherits {
   static TypeInfo? _typeInfo;
   static final _bindings = _${classInfo.godotType}Bindings();
   static Map<String, Pointer<GodotVirtualFunction>>? _vTable;
+  @pragma('vm:entry-point')
   static Map<String, Pointer<GodotVirtualFunction>> get vTable {
     if (_vTable == null) {
       _initVTable();
@@ -55,8 +58,8 @@ class ${classInfo.dartType} extends $correctedInherits {
 
   static TypeInfo get typeInfo {
     _typeInfo ??= TypeInfo(
-      StringName.fromString('${classInfo.godotType}'),
-      parentClass: StringName.fromString('$inherits'),
+      ${godotNames.reference(classInfo.godotType)},
+      parentClass: ${godotNames.reference(inherits)},
       bindingCallbacks: bindingCallbacks,
     );
     return _typeInfo!;
@@ -104,8 +107,6 @@ class ${classInfo.dartType} extends $correctedInherits {
     for (Map<String, dynamic> method in methods) {
       final methodName = escapeMethodName(method['name'] as String);
       final returnInfo = api.getReturnInfo(method);
-      final hasReturn =
-          returnInfo.typeInfo.typeCategory != TypeCategory.voidType;
       final isStatic = method['is_static'] as bool;
       final signature = makeSignature(api, method);
 
@@ -123,37 +124,21 @@ class ${classInfo.dartType} extends $correctedInherits {
             .map((dynamic e) => api.getArgumentInfo(e))
             .toList();
 
-        // TODO: Research if we can do ptrCalls
         out.write('''
     var method = _bindings.method${methodName.toUpperCamelCase()};
     if (method == null) {
       _bindings.method${methodName.toUpperCamelCase()} = gde.classDbGetMethodBind(
-             typeInfo.className, StringName.fromString('${method['name']}'), ${method['hash']});
+             typeInfo.className, ${godotNames.reference(method['name'])}, ${method['hash']});
       method = _bindings.method${methodName.toUpperCamelCase()};
     }
-    ${hasReturn ? 'final ret = ' : ''}gde.callNativeMethodBind(method!, ${isStatic ? 'null' : 'this'}, [
-''');
-        for (final argument in arguments) {
-          out.write('      convertToVariant(${argument.name}),\n');
-        }
-
-        out.write('''
-    ]);
 ''');
-
-        if (hasReturn) {
-          var bindingCallbacks = 'null';
-          if (returnInfo.typeInfo.typeCategory == TypeCategory.engineClass) {
-            bindingCallbacks = '${returnInfo.dartType}.bindingCallbacks';
-          }
-
-          if (returnInfo.typeInfo.typeCategory == TypeCategory.enumType) {
-            out.write(
-                '    return ${returnInfo.fullDartType}.fromValue(convertFromVariant(ret, $bindingCallbacks) as int);');
-          } else {
-            out.write(
-                '    return convertFromVariant(ret, $bindingCallbacks) as ${returnInfo.fullDartType};\n');
-          }
+        // ptrcall can't pass extra arguments, so varargs methods still go
+        // through Variants
+        if (method['is_vararg'] == true) {
+          _writeVariantCall(out, isStatic, arguments, returnInfo);
+        } else {
+          _writePtrCall(out, isStatic, arguments, returnInfo,
+              retSlot: '_bindings.ret${methodName.toUpperCamelCase()}');
         }
       }
 
@@ -173,25 +158,15 @@ class ${classInfo.dartType} extends $correctedInherits {
   static Pointer<Void> _bindingCreateCallback(
       Pointer<Void> token, Pointer<Void> instance) {
     final dartInstance = ${classInfo.dartType}.withNonNullOwner(instance);
-    return gde.dartBindings.toPersistentHandle(dartInstance);
-  }
-
-  static void _bindingFreeCallback(
-      Pointer<Void> token, Pointer<Void> instance, Pointer<Void> binding) {
-    gde.dartBindings.clearPersistentHandle(binding);
-  }
-
-  static int _bindingReferenceCallback(
-      Pointer<Void> token, Pointer<Void> instance, int reference) {
-    return 1;
+    return gde.dartBindings.newInstanceHandle(dartInstance);
   }
 
   static void _initBindings() {
     _bindingCallbacks = malloc<GDExtensionInstanceBindingCallbacks>();
     _bindingCallbacks!.ref
       ..create_callback = Pointer.fromFunction(_bindingCreateCallback)
-      ..free_callback = Pointer.fromFunction(_bindingFreeCallback)
-      ..reference_callback = Pointer.fromFunction(_bindingReferenceCallback, 1);
+      ..free_callback = gde.dartBindings.bindingFreeCallback
+      ..reference_callback = gde.dartBindings.bindingReferenceCallback;
     _initVTable();
   }
 
@@ -233,7 +208,7 @@ class ${classInfo.dartType} extends $correctedInherits {
   static void __$methodName(GDExtensionClassInstancePtr instance,
     Pointer<GDExtensionConstTypePtr> args, GDExtensionTypePtr retPtr) {
     
-    final self = gde.dartBindings.fromPersistentHandle(instance) as ${classInfo.dartType};
+    final self = gde.dartBindings.fromInstanceHandle(instance) as ${classInfo.dartType};
 ''');
       arguments.forEachIndexed((i, e) {
         out.write(convertPtrArgument(i, e));
@@ -273,6 +248,10 @@ class _${classInfo.godotType}Bindings {\n''');
       var methodName = escapeMethodName(method['name'] as String);
       methodName = methodName.toUpperCamelCase();
       out.write('''  GDExtensionMethodBindPtr? method$methodName;\n''');
+      final returnInfo = api.getReturnInfo(method);
+      if (method['is_vararg'] != true && _returnsStructByValue(returnInfo)) {
+        out.write('''  Pointer<${returnInfo.dartType}>? ret$methodName;\n''');
+      }
     }
     out.write('}\n');
 
@@ -288,3 +267,220 @@ class _${classInfo.godotType}Bindings {\n''');
 
   await out.close();
 }
+
+void _writeVariantCall(IOSink out, bool isStatic, List<ArgumentInfo> arguments,
+    ArgumentInfo returnInfo) {
+  final hasReturn = returnInfo.typeInfo.typeCategory != TypeCategory.voidType;
+  out.write('''
+    ${hasReturn ? 'final ret = ' : ''}gde.callNativeMethodBind(method!, ${isStatic ? 'null' : 'this'}, [
+''');
+  // Arguments are converted to Variants by callNativeMethodBind
+  for (final argument in arguments) {
+    if (argument.typeInfo.typeCategory == TypeCategory.enumType) {
+      out.write('      ${argument.name}.value,\n');
+    } else {
+      out.write('      ${argument.name},\n');
+    }
+  }
+
+  var bindingCallbacks = '';
+  if (returnInfo.typeInfo.typeCategory == TypeCategory.engineClass) {
+    bindingCallbacks = ', ${returnInfo.dartType}.bindingCallbacks';
+  }
+  out.write('''
+    ]$bindingCallbacks);
+''');
+
+  if (hasReturn) {
+    if (returnInfo.typeInfo.typeCategory == TypeCategory.enumType) {
+      out.write(
+          '    return ${returnInfo.fullDartType}.fromValue(ret as int);\n');
+    } else {
+      out.write('    return ret as ${returnInfo.fullDartType};\n');
+    }
+  }
+}
+
+/// ptrcall takes primitives at their widest size: every int is an int64_t and
+/// every float a double, whatever the argument's meta says.
+String _ptrCallFFIType(ArgumentInfo argument) {
+  switch (argument.typeInfo.godotType) {
+    case 'bool':
+      return 'Bool';
+    case 'int':
+      return 'Int64';
+    case 'float':
+      return 'Double';
+  }
+  return getFFIType(argument)!;
+}
+
+bool _returnsStructByValue(ArgumentInfo returnInfo) =>
+    returnInfo.typeInfo.typeCategory == TypeCategory.nativeStructure &&
+    !returnInfo.isPointer;
+
+bool _isRefCounted(ArgumentInfo argument) =>
+    argument.typeInfo.api['is_refcounted'] == true;
+
+/// Write a call through `object_method_bind_ptrcall`, which takes pointers to
+/// the arguments and to the return value in their native form instead of
+/// Variants.
+///
+/// A structure returned by value is a view of its slot, which can't live in
+/// the arena. [retSlot] names the field holding the method's slot, allocated
+/// on the first call and reused by the next, so the structure is only valid
+/// until the method is called again.
+void _writePtrCall(IOSink out, bool isStatic, List<ArgumentInfo> arguments,
+    ArgumentInfo returnInfo,
+    {required String retSlot}) {
+  final allocations = <String>[];
+  final argumentPtrs = <String>[];
+
+  String slot(String name, String ffiType, String value) {
+    allocations.add(
+        'final ${name}Ptr = arena.allocate<$ffiType>(sizeOf<$ffiType>())..value = $value;');
+    return '${name}Ptr.cast()';
+  }
+
+  for (final argument in arguments) {
+    final name = argument.name!;
+    switch (argument.typeInfo.typeCategory) {
+      case TypeCategory.primitive:
+        argumentPtrs.add(argument.isPointer
+            ? '$name.cast()'
+            : slot(name, _ptrCallFFIType(argument), name));
+        break;
+      case TypeCategory.enumType:
+        argumentPtrs.add(slot(name, 'Int64', '$name.value'));
+        break;
+      case TypeCategory.engineClass:
+        // Godot 4.0 takes a Ref<T> argument as the object pointer itself, and
+        // any other object as a pointer to the object pointer
+        argumentPtrs.add(_isRefCounted(argument)
+            ? '$name?.nativePtr ?? nullptr'
+            : slot(name, 'GDExtensionObjectPtr', '$name?.nativePtr ?? nullptr'));
+        break;
+      case TypeCategory.builtinClass:
+      case TypeCategory.typedArray:
+        final layout = valueTypeOf(argument);
+        if (layout != null) {
+          // Value types are written to the arena
+          allocations
+            ..add('final ${name}Ptr = arena.allocate<Uint8>(${layout.size});')
+            ..add('$name.copyToNative(${name}Ptr.cast());');
+          argumentPtrs.add('${name}Ptr.cast()');
+        } else {
+          argumentPtrs.add('$name.nativePtr.cast()');
+        }
+        break;
+      case TypeCategory.nativeStructure:
+        if (argument.isPointer) {
+          argumentPtrs.add('$name.cast()');
+        } else {
+          allocations.add(
+              'final ${name}Ptr = arena.allocate<${argument.dartType}>(sizeOf<${argument.dartType}>())..ref = $name;');
+          argumentPtrs.add('${name}Ptr.cast()');
+        }
+        break;
+      case TypeCategory.voidType:
+        argumentPtrs.add('nullptr');
+        break;
+    }
+  }
+
+  // Builtins are returned straight into a new Dart object, everything else
+  // into a slot that is converted after the call
+  var retArgument = 'nullptr';
+  String? retValue;
+  var retDeclaration = '';
+  switch (returnInfo.typeInfo.typeCategory) {
+    case TypeCategory.voidType:
+      break;
+    case TypeCategory.builtinClass:
+    case TypeCategory.typedArray:
+      final layout = valueTypeOf(returnInfo);
+      if (layout != null) {
+        retDeclaration = '    late ${returnInfo.dartType} retVal;\n';
+        allocations.add('final retPtr = arena.allocate<Uint8>(${layout.size});');
+        retArgument = 'retPtr.cast()';
+        retValue = '${returnInfo.dartType}.fromPointer(retPtr.cast())';
+        break;
+      }
+      final isString = returnInfo.typeInfo.godotType == 'String';
+      retDeclaration =
+          '    final retVal = ${isString ? 'GDString' : returnInfo.dartType}();\n';
+      retArgument = 'retVal.nativePtr.cast()';
+      break;
+    case TypeCategory.primitive:
+    case TypeCategory.enumType:
+    case TypeCategory.engineClass:
+    case TypeCategory.nativeStructure:
+      final String slotType;
+      final String converted;
+      if (returnInfo.isPointer) {
+        slotType = returnInfo.dartType;
+        converted = 'retPtr.value';
+      } else if (returnInfo.typeInfo.typeCategory == TypeCategory.primitive) {
+        slotType = _ptrCallFFIType(returnInfo);
+        converted = 'retPtr.value';
+      } else if (returnInfo.typeInfo.typeCategory == TypeCategory.enumType) {
+        slotType = 'Int64';
+        converted = '${returnInfo.fullDartType}.fromValue(retPtr.value)';
+      } else if (returnInfo.typeInfo.typeCategory ==
+          TypeCategory.engineClass) {
+        // A returned Ref<T> comes with a reference for the caller to release
+        final conversion = _isRefCounted(returnInfo)
+            ? 'refToDartObject'
+            : 'gdObjectToDartObject';
+        slotType = 'GDExtensionObjectPtr';
+        converted =
+            'gde.dartBindings.$conversion(retPtr.value, ${returnInfo.dartType}.bindingCallbacks) as ${returnInfo.fullDartType}';
+      } else {
+        slotType = returnInfo.dartType;
+        converted = 'retPtr.ref';
+      }
+
+      if (_returnsStructByValue(returnInfo)) {
+        retDeclaration = '    late ${returnInfo.fullDartType} retVal;\n';
+        allocations.add('final retPtr = $retSlot ??= malloc<$slotType>();');
+      } else {
+        retDeclaration =
+            '    ${returnInfo.fullDartType} retVal = ${getDefaultValueForAgument(returnInfo)};\n';
+        allocations.add(
+            'final retPtr = arena.allocate<$slotType>(sizeOf<$slotType>());');
+      }
+      retArgument = 'retPtr.cast()';
+      retValue = converted;
+      break;
+  }
+
+  out.write(retDeclaration);
+  var indent = '    ';
+  if (allocations.isNotEmpty) {
+    out.write('    gde.scratch.scope((arena) {\n');
+    indent = '      ';
+    for (final allocation in allocations) {
+      out.write('$indent$allocation\n');
+    }
+  }
+  out.write(
+      '${indent}gde.callNativeMethodBindPtrCall(method!, ${isStatic ? 'null' : 'this'}, $retArgument, [\n');
+  for (final argumentPtr in argumentPtrs) {
+    out.write('$indent  $argumentPtr,\n');
+  }
+  out.write('$indent]);\n');
+  if (retValue != null) {
+    out.write('${indent}retVal = $retValue;\n');
+  }
+  if (allocations.isNotEmpty) {
+    out.write('    });\n');
+  }
+
+  if (returnInfo.typeInfo.typeCategory != TypeCategory.voidType) {
+    if (returnInfo.typeInfo.godotType == 'String') {
+      out.write('    return retVal.toDartString();\n');
+    } else {
+      out.write('    return retVal;\n');
+    }
+  }
+}
@@ -0,0 +1,104 @@
+import 'dart:io';
+
+import 'package:path/path.dart' as path;
+
+import 'common_helpers.dart';
+import 'string_extensions.dart';
+
+const _reservedIdentifiers = {
+  'assert', 'break', 'case', 'catch', 'class', 'const', 'continue', //
+  'default', 'do', 'else', 'enum', 'extends', 'false', 'final', 'finally',
+  'for', 'if', 'in', 'is', 'new', 'null', 'rethrow', 'return', 'super',
+  'switch', 'this', 'throw', 'true', 'try', 'var', 'void', 'while', 'with',
+  // Members of GodotNames itself
+  'init',
+};
+
+/// Collects the StringNames used by the generated bindings so they can be
+/// written out as the `GodotNames` table instead of being created one at a
+/// time where they are used.
+class GodotNamesTable {
+  final _identifiers = <String, String>{};
+  final _usedIdentifiers = <String>{};
+
+  /// Adds [name] to the table and returns the Dart expression for it.
+  String reference(String name) {
+    final identifier =
+        _identifiers.putIfAbsent(name, () => _makeIdentifier(name));
+    return 'GodotNames.$identifier';
+  }
+
+  String _makeIdentifier(String name) {
+    var base = name
+        .replaceAll(RegExp('[^A-Za-z0-9_]'), '_')
+        .toLowerCamelCase()
+        .replaceFirst(RegExp('^_+'), '');
+    if (base.isEmpty || base.startsWith(RegExp('[0-9]'))) {
+      base = 'n$base';
+    }
+
+    var identifier = base;
+    var suffix = 2;
+    while (_reservedIdentifiers.contains(identifier) ||
+        _usedIdentifiers.contains(identifier)) {
+      identifier = '$base${suffix++}';
+    }
+    _usedIdentifiers.add(identifier);
+
+    return identifier;
+  }
+
+  Future<void> write(String targetDir) async {
+    final out = File(path.join(targetDir, 'godot_names.dart')).openWrite();
+
+    out.write(header);
+    out.write('''
+import 'dart:ffi';
+
+import '../core/gdextension.dart';
+import 'variant/string_name.dart';
+
+/// Every StringName used by the generated bindings.
+///
+/// [init] interns all of them with a single native call. The StringName
+/// objects wrap the interned names, which live as long as the extension, and
+/// are created on first use.
+class GodotNames {
+  static late final Pointer<Pointer<Uint8>> _interned;
+
+  static void init() {
+    _interned = gde.dartBindings.internStringNames(_names, _hashes);
+  }
+
+  static StringName _at(int index) => StringName.unowned(_interned[index]);
+
+''');
+
+    final names = _identifiers.keys.toList();
+    for (var i = 0; i < names.length; ++i) {
+      out.write(
+          '  static final StringName ${_identifiers[names[i]]} = _at($i);\n');
+    }
+
+    out.write('\n  static const _names = <String>[\n');
+    for (final name in names) {
+      final escaped = name
+          .replaceAll(r'\', r'\\')
+          .replaceAll("'", r"\'")
+          .replaceAll(r'$', r'\$');
+      out.write("    '$escaped',\n");
+    }
+    out.write('  ];\n');
+
+    out.write('\n  static const _hashes = <int>[\n');
+    for (final name in names) {
+      out.write('    ${stringNameHashLiteral(name)},\n');
+    }
+    out.write('  ];\n}\n');
+
+    await out.close();
+  }
+}
+
+/// The names used by everything generated in this run.
+final godotNames = GodotNamesTable();
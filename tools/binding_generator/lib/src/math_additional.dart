@@ -0,0 +1,212 @@
+// Additional functions that need to be added to the generated code for the
+// math value types. These implement the hot math methods in Dart instead of
+// calling into Godot, and batch versions over typed data that use the SIMD
+// kernels in math_kernels.dart.
+
+import 'value_types.dart';
+
+/// Godot methods that are implemented in Dart instead of being bound
+const dartMathMethods = <String, Set<String>>{
+  'Vector3': {'dot', 'cross', 'length', 'length_squared', 'normalized'},
+  'AABB': {'has_point', 'intersects'},
+};
+
+const _mathTypes = ['Vector3', 'Basis', 'Transform3D', 'AABB', 'Plane'];
+
+/// Whether the Dart math code can be used, which needs all the types it works
+/// with to be value types.
+bool hasDartMath(String godotType) =>
+    _mathTypes.contains(godotType) && _mathTypes.every(valueTypes.containsKey);
+
+/// Imports needed by [mathAdditional] for [godotType]
+String mathImports(String godotType) {
+  if (!hasDartMath(godotType)) return '';
+
+  switch (godotType) {
+    case 'Vector3':
+      return "import 'dart:math' as math;\n";
+    case 'Transform3D':
+    case 'AABB':
+      return "import '../../variant/math_kernels.dart';\n";
+  }
+  return '';
+}
+
+String mathAdditional(String godotType) {
+  if (!hasDartMath(godotType)) return '';
+
+  switch (godotType) {
+    case 'Vector3':
+      return _vector3Math();
+    case 'Basis':
+      return _basisMath();
+    case 'Transform3D':
+      return _transform3DMath();
+    case 'AABB':
+      return _aabbMath();
+  }
+  return '';
+}
+
+String _vector3Math() {
+  return '''
+
+  double dot(Vector3 withVal) {
+    final a = components;
+    final b = withVal.components;
+    return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+  }
+
+  Vector3 cross(Vector3 withVal) {
+    final a = components;
+    final b = withVal.components;
+    return Vector3.fromXYZ(
+      a[1] * b[2] - a[2] * b[1],
+      a[2] * b[0] - a[0] * b[2],
+      a[0] * b[1] - a[1] * b[0],
+    );
+  }
+
+  double lengthSquared() => dot(this);
+
+  double length() => math.sqrt(lengthSquared());
+
+  Vector3 normalized() {
+    final lengthSq = lengthSquared();
+    if (lengthSq == 0) {
+      return Vector3.fromXYZ(0, 0, 0);
+    }
+    final length = math.sqrt(lengthSq);
+    return Vector3.fromXYZ(
+      components[0] / length,
+      components[1] / length,
+      components[2] / length,
+    );
+  }
+''';
+}
+
+// Basis (and the basis of Transform3D) is stored as three rows
+String _basisMath() {
+  return '''
+
+  /// Transform [vector] by this basis, like `basis * vector` in GDScript.
+  Vector3 xform(Vector3 vector) {
+    final m = components;
+    final v = vector.components;
+    return Vector3.fromXYZ(
+      m[0] * v[0] + m[1] * v[1] + m[2] * v[2],
+      m[3] * v[0] + m[4] * v[1] + m[5] * v[2],
+      m[6] * v[0] + m[7] * v[1] + m[8] * v[2],
+    );
+  }
+
+  Basis operator *(Basis other) {
+    final a = components;
+    final b = other.components;
+    final result = Basis.copy(this);
+    final r = result.components;
+    for (var row = 0; row < 9; row += 3) {
+      for (var column = 0; column < 3; ++column) {
+        r[row + column] = a[row] * b[column] +
+            a[row + 1] * b[3 + column] +
+            a[row + 2] * b[6 + column];
+      }
+    }
+    return result;
+  }
+''';
+}
+
+String _transform3DMath() {
+  return '''
+
+  /// Transform [vector] by this transform, like `transform * vector` in
+  /// GDScript.
+  Vector3 xform(Vector3 vector) {
+    final m = components;
+    final v = vector.components;
+    return Vector3.fromXYZ(
+      m[0] * v[0] + m[1] * v[1] + m[2] * v[2] + m[9],
+      m[3] * v[0] + m[4] * v[1] + m[5] * v[2] + m[10],
+      m[6] * v[0] + m[7] * v[1] + m[8] * v[2] + m[11],
+    );
+  }
+
+  Transform3D operator *(Transform3D other) {
+    final a = components;
+    final b = other.components;
+    final result = Transform3D.copy(this);
+    final r = result.components;
+    for (var row = 0; row < 9; row += 3) {
+      for (var column = 0; column < 3; ++column) {
+        r[row + column] = a[row] * b[column] +
+            a[row + 1] * b[3 + column] +
+            a[row + 2] * b[6 + column];
+      }
+      r[9 + row ~/ 3] = a[row] * b[9] +
+          a[row + 1] * b[10] +
+          a[row + 2] * b[11] +
+          a[9 + row ~/ 3];
+    }
+    return result;
+  }
+
+  /// Transform the points packed as x, y, z in [points], such as the data of
+  /// a PackedVector3Array, into [out] or back into [points].
+  void xformPoints(Float32List points, [Float32List? out]) {
+    final m = components;
+    transformPoints(
+      Float32x4(m[0], m[3], m[6], 0),
+      Float32x4(m[1], m[4], m[7], 0),
+      Float32x4(m[2], m[5], m[8], 0),
+      Float32x4(m[9], m[10], m[11], 0),
+      points,
+      out ?? points,
+    );
+  }
+''';
+}
+
+String _aabbMath() {
+  return '''
+
+  bool hasPoint(Vector3 point) {
+    final box = components;
+    final p = point.components;
+    for (var i = 0; i < 3; ++i) {
+      if (p[i] < box[i] || p[i] > box[i] + box[3 + i]) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  bool intersects(AABB withVal) {
+    final a = components;
+    final b = withVal.components;
+    for (var i = 0; i < 3; ++i) {
+      if (a[i] >= b[i] + b[3 + i] || a[i] + a[3 + i] <= b[i]) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /// Cull the boxes packed as position x, y, z, size x, y, z in [aabbs]
+  /// against the convex volume bounded by [planes], such as a camera frustum.
+  /// Sets [visible] to 1 for the boxes that are kept and 0 for the others,
+  /// and returns the number kept.
+  static int cull(Float32List aabbs, List<Plane> planes, Uint8List visible) {
+    return cullAabbs(
+      aabbs,
+      [
+        for (final plane in planes)
+          Float32x4(plane.components[0], plane.components[1],
+              plane.components[2], plane.components[3]),
+      ],
+      visible,
+    );
+  }
+''';
+}
@@ -0,0 +1,194 @@
+import 'package:collection/collection.dart';
+
+import 'godot_api_info.dart';
+import 'type_info.dart';
+
+/// A member of a value type, which is either a single component or a nested
+/// value type spanning [count] components.
+class ValueTypeMember {
+  final String name;
+  final String godotType;
+  final int index;
+  final int count;
+  final bool isScalar;
+
+  ValueTypeMember({
+    required this.name,
+    required this.godotType,
+    required this.index,
+    required this.count,
+    required this.isScalar,
+  });
+}
+
+/// The layout of a fixed size math builtin (Vector2, Color, Transform3D...)
+/// that is generated as a Dart value class. Its components are all the same
+/// scalar type, so they're held in a single typed list and only copied to
+/// native memory when passed to Godot.
+class ValueTypeLayout {
+  final String godotType;
+  final _ScalarKind _kind;
+  final int componentCount;
+  final List<ValueTypeMember> members;
+
+  ValueTypeMember? member(String name) =>
+      members.firstWhereOrNull((e) => e.name == name);
+
+  ValueTypeLayout._(
+      this.godotType, this._kind, this.componentCount, this.members);
+
+  /// The typed list holding the components, such as `Float32List`
+  String get listType => _kind.listType;
+
+  /// The FFI type of a single component, such as `Float`
+  String get ffiType => _kind.ffiType;
+
+  /// The Dart type of a single component, `double` or `int`
+  String get scalarType => _kind.scalarType;
+
+  bool get isIntegral => _kind.scalarType == 'int';
+
+  /// The size of the type in bytes
+  int get size => componentCount * _kind.size;
+}
+
+class _ScalarKind {
+  final String listType;
+  final String ffiType;
+  final String scalarType;
+  final int size;
+
+  const _ScalarKind(this.listType, this.ffiType, this.scalarType, this.size);
+}
+
+const _scalarKinds = {
+  'float': _ScalarKind('Float32List', 'Float', 'double', 4),
+  'double': _ScalarKind('Float64List', 'Double', 'double', 8),
+  'int32': _ScalarKind('Int32List', 'Int32', 'int', 4),
+};
+
+/// Builtins generated as Dart value classes, found by [findValueTypes]
+final valueTypes = <String, ValueTypeLayout>{};
+
+/// The value type layout of [argument], if it is passed by value
+ValueTypeLayout? valueTypeOf(ArgumentInfo argument) {
+  if (argument.isPointer ||
+      argument.typeInfo.typeCategory != TypeCategory.builtinClass) {
+    return null;
+  }
+  return valueTypes[argument.typeInfo.godotType];
+}
+
+/// Find the builtins that can be Dart value classes in [buildConfig]: those
+/// without a destructor whose members, as listed in the API's member offsets,
+/// are all the same kind of scalar and exactly cover the type.
+void findValueTypes(GodotApiInfo api, String buildConfig) {
+  final sizes = <String, int>{};
+  for (Map<String, dynamic> sizeList in api.raw['builtin_class_sizes']) {
+    if (sizeList['build_configuration'] == buildConfig) {
+      for (Map<String, dynamic> size in sizeList['sizes']) {
+        sizes[size['name']] = size['size'];
+      }
+    }
+  }
+
+  final offsets = <String, List<dynamic>>{};
+  for (Map<String, dynamic> offsetList
+      in api.raw['builtin_class_member_offsets']) {
+    if (offsetList['build_configuration'] == buildConfig) {
+      for (Map<String, dynamic> classOffsets in offsetList['classes']) {
+        offsets[classOffsets['name']] = classOffsets['members'];
+      }
+    }
+  }
+
+  final failed = <String>{};
+  ValueTypeLayout? find(String type) {
+    final found = valueTypes[type];
+    if (found != null || failed.contains(type)) return found;
+
+    final layout = _makeLayout(api, type, sizes, offsets, find);
+    if (layout == null) {
+      failed.add(type);
+    } else {
+      valueTypes[type] = layout;
+    }
+    return layout;
+  }
+
+  offsets.keys.forEach(find);
+}
+
+ValueTypeLayout? _makeLayout(
+  GodotApiInfo api,
+  String type,
+  Map<String, int> sizes,
+  Map<String, List<dynamic>> offsets,
+  ValueTypeLayout? Function(String) find,
+) {
+  final builtin = api.builtinClasses[type];
+  final memberOffsets = offsets[type];
+  final size = sizes[type];
+  if (builtin == null ||
+      memberOffsets == null ||
+      size == null ||
+      builtin.api['has_destructor'] == true) {
+    return null;
+  }
+
+  _ScalarKind? kind;
+  final members = <ValueTypeMember>[];
+  var componentCount = 0;
+  for (Map<String, dynamic> memberOffset in memberOffsets) {
+    final String meta = memberOffset['meta'];
+    final int offset = memberOffset['offset'];
+
+    _ScalarKind memberKind;
+    var count = 1;
+    final scalarKind = _scalarKinds[meta];
+    if (scalarKind != null) {
+      memberKind = scalarKind;
+    } else {
+      final nested = find(meta);
+      if (nested == null) return null;
+      memberKind = nested._kind;
+      count = nested.componentCount;
+    }
+
+    kind ??= memberKind;
+    if (!identical(kind, memberKind) || offset != componentCount * kind.size) {
+      return null;
+    }
+
+    members.add(ValueTypeMember(
+      name: memberOffset['member'],
+      godotType: scalarKind != null ? _scalarGodotType(meta) : meta,
+      index: componentCount,
+      count: count,
+      isScalar: scalarKind != null,
+    ));
+    componentCount += count;
+  }
+
+  if (kind == null || componentCount * kind.size != size) {
+    return null;
+  }
+
+  // The stored members have to be ones Godot exposes. Godot can expose more
+  // (Color.h or Color.r8), which are computed by Godot from the stored ones.
+  final apiMembers = builtin.api['members'] as List<dynamic>? ?? <dynamic>[];
+  final apiMemberNames = apiMembers.map((dynamic m) => m['name']).toSet();
+  if (!members.every((e) => apiMemberNames.contains(e.name))) {
+    return null;
+  }
+
+  // Basis is stored as rows, but its x, y and z members are its columns, so
+  // they are left to Godot
+  if (type == 'Basis') {
+    members.clear();
+  }
+
+  return ValueTypeLayout._(type, kind, componentCount, members);
+}
+
+String _scalarGodotType(String meta) => meta == 'int32' ? 'int' : 'float';